@@ -5,12 +5,15 @@
 #pragma once
 #include <functional>
 #include <optional>
+#include <type_traits>
+#include <utility>
 #include <QObject>
 #include <QSharedPointer>
 #include <QFuture>
 #include <QFutureInterface>
 #include <QFutureWatcher>
 #include <QPair>
+#include <QThreadPool>
 #include <utils-cpp/pimpl.h>
 #include <utils-cpp/function_traits.h>
 #include <utils-cpp/default_ctor_ops.h>
@@ -21,6 +24,7 @@
 
   There is single function:
     QFuture convertFuture(context, future, flags, converter);
+    QFuture convertFuture(context, future, flags, threadPool, converter);
 
   Is used to convert QFuture<T1> to QFuture<T2>. For example: one async operation returns raw buffer,
   while intermediate module should return QFuture of parsed data based on the raw buffer.
@@ -65,14 +69,44 @@
   Source futures will be canceled, if target future is canceled and vice-versa.
   So futures cancellation is transitive and bi-directional.
 
+  Converter receives a reference to the result stored in source future (no intermediate copy) and
+  its result is moved into the resulting future.
+
   Possible 'flags' values:
    - IgnoreNullContext      - don't cancel resulting future if nullptr is passed as a context.
+   - RunInThreadPool        - run converter in QThreadPool::globalInstance() instead of context's thread.
+
+  Off-thread conversion (RunInThreadPool or explicit 'threadPool'):
+  /
+  |  auto f = convertFuture(this, downloadAsync(), ConverterFlags::RunInThreadPool, [](const QByteArray& raw) {
+  |      return parseHugeJson(raw); // Doesn't block 'this' thread
+  |  });
+  \
+  Lifetime and cancellation rules are the same: if 'context' is destroyed or resulting future is
+  canceled while converter is running, its result is discarded and resulting future stays canceled.
+  Notice that converter can't be interrupted, and it mustn't touch 'context' (it runs in another thread).
+
+
+  Chains of conversions:
+  /
+  |  QFuture<Item> f = convertChain(this, downloadAsync())    // QFuture<QByteArray>
+  |                       .map([](const QByteArray& raw) { return parse(raw); })
+  |                       .filter([](const Document& doc) { return doc.isValid(); })
+  |                       .map([](Document doc) { return doc.firstItem(); })
+  |                       .execute();
+  \
+  Stages are fused into single converter, so the chain costs exactly as much as one convertFuture call
+  (one context, one pair of watchers, one resulting future) regardless of its length.
+  Stage can return value or std::optional (nullopt cancels resulting future), values are moved
+  between stages. Failed 'filter' cancels resulting future as well.
+  convertChain accepts the same 'flags' and 'threadPool' as convertFuture (whole chain runs in the pool).
 */
 
 namespace UtilsQt {
 enum class ConverterFlags
 {
-    IgnoreNullContext = 1 // Otherwise cancel on null context
+    IgnoreNullContext = 1, // Otherwise cancel on null context
+    RunInThreadPool = 2    // Run converter in QThreadPool::globalInstance()
 };
 } // namespace UtilsQt
 
@@ -127,10 +161,14 @@ auto fixConverter(const T& func)
 template <typename SrcFutureType, typename Converter, typename DstFutureType>
 bool convert(const QFuture<SrcFutureType>& srcFuture, const Converter& converter, QFutureInterface<DstFutureType>& futureInterface)
 {
-    const auto result = converter(srcFuture.result());
+    if (srcFuture.resultCount() == 0)
+        return false;
+
+    // Reference to the stored result, unlike QFuture::result() which returns a copy
+    auto result = converter(*srcFuture.constBegin());
 
     if (result) {
-        futureInterface.reportResult(*result);
+        futureInterface.reportResult(std::move(*result));
         futureInterface.reportFinished();
     }
 
@@ -140,10 +178,10 @@ bool convert(const QFuture<SrcFutureType>& srcFuture, const Converter& converter
 template <typename Converter, typename DstFutureType>
 bool convert(const QFuture<void>& /*srcFuture*/, const Converter& converter, QFutureInterface<DstFutureType>& futureInterface)
 {
-    const auto result = converter();
+    auto result = converter();
 
     if (result) {
-        futureInterface.reportResult(*result);
+        futureInterface.reportResult(std::move(*result));
         futureInterface.reportFinished();
     }
 
@@ -172,9 +210,10 @@ public:
     using TargetWatcher = QFutureWatcher<Target>;
     using Converter = typename ConverterType<Source, Target>::Converter;
 
-    Context(QObject* context, const SourceFuture& future, const Converter& converter)
+    Context(QObject* context, const SourceFuture& future, const Converter& converter, QThreadPool* threadPool)
         : QObject(context),
-          m_converter(converter)
+          m_converter(converter),
+          m_threadPool(threadPool)
     {
         if (future.isStarted())
             m_targetFutureInterface.reportStarted();
@@ -206,6 +245,9 @@ private:
     void handleFinished(const SourceFuture& future) {
         if (future.isCanceled()) {
             doCancel();
+        } else if (m_threadPool) {
+            runInThreadPool(future);
+            return; // Deleted when resulting future is finished
         } else {
             auto convertedResult = convert(future, m_converter, m_targetFutureInterface);
 
@@ -216,6 +258,18 @@ private:
         deleteLater();
     }
 
+    void runInThreadPool(const SourceFuture& future) {
+        QObject::connect(&m_targetWatcher, &TargetWatcher::finished, this, &QObject::deleteLater);
+
+        m_threadPool->start([future, converter = m_converter, target = m_targetFutureInterface]() mutable {
+            // Resulting future could be canceled by user or by context destruction meanwhile
+            if (target.isCanceled() || !convert(future, converter, target))
+                target.reportCanceled();
+
+            target.reportFinished();
+        });
+    }
+
     void doCancel() {
         if (!m_sourceWatcher.future().isCanceled())
             m_sourceWatcher.future().cancel();
@@ -231,6 +285,59 @@ private:
     QFutureInterface<Target> m_targetFutureInterface;
     SourceWatcher m_sourceWatcher;
     TargetWatcher m_targetWatcher;
+    QThreadPool* m_threadPool;
+};
+
+template<typename Source, typename Target>
+QFuture<Target> startConversion(QObject* context,
+                                const QFuture<Source>& srcFuture,
+                                ConverterFlags flags,
+                                QThreadPool* threadPool,
+                                const typename ConverterType<Source, Target>::Converter& converter)
+{
+    if (!context && !(flags & ConverterFlags::IgnoreNullContext)) {
+        QFutureInterface<Target> result;
+        result.reportCanceled();
+        result.reportFinished();
+        return result.future();
+    }
+
+    if (!threadPool && (flags & ConverterFlags::RunInThreadPool))
+        threadPool = QThreadPool::globalInstance();
+
+    auto ctx = new Context<Source, Target>(context, srcFuture, converter, threadPool);
+    return ctx->targetFuture();
+}
+
+struct IdentityStage { };
+
+// Calls chain stage and wraps its result into std::optional, if it isn't yet
+template<typename F, typename... Args>
+auto invokeStage(F& f, Args&&... args)
+{
+    using R = std::invoke_result_t<F&, Args...>;
+    static_assert(!std::is_void_v<R>, "Chain stage should return value or std::optional");
+
+    if constexpr (IsOptional<R>::value) {
+        return f(std::forward<Args>(args)...);
+    } else {
+        return std::optional<R>(f(std::forward<Args>(args)...));
+    }
+}
+
+template<typename F, typename... Args>
+using StageResult = typename decltype(invokeStage(std::declval<F&>(), std::declval<Args>()...))::value_type;
+
+template<typename Source, typename F>
+struct FirstStageResult
+{
+    using Type = StageResult<F, const Source&>;
+};
+
+template<typename F>
+struct FirstStageResult<void, F>
+{
+    using Type = StageResult<F>;
 };
 
 } // namespace FutureConverterInternal
@@ -244,17 +351,24 @@ template<typename Source, typename Target = std::nullptr_t, typename Converter,
 [[nodiscard]] QFuture<SelectedTarget> convertFuture(QObject* context,
                               const QFuture<Source>& srcFuture,
                               ConverterFlags flags,
+                              QThreadPool* threadPool,
                               const Converter& converter)
 {
-    if (!context && !(flags & ConverterFlags::IgnoreNullContext)) {
-        QFutureInterface<SelectedTarget> result;
-        result.reportCanceled();
-        result.reportFinished();
-        return result.future();
-    }
+    return FutureConverterInternal::startConversion<Source, SelectedTarget>(context, srcFuture, flags, threadPool, FutureConverterInternal::fixConverter(converter));
+}
 
-    auto ctx = new FutureConverterInternal::Context<Source, SelectedTarget>(context, srcFuture, FutureConverterInternal::fixConverter(converter));
-    return ctx->targetFuture();
+template<typename Source, typename Target = std::nullptr_t, typename Converter,
+         typename FixedConverter = decltype (FutureConverterInternal::fixConverter(std::declval<Converter>())),
+         typename SelectedTarget = std::conditional_t<
+             std::is_same_v<Target, std::nullptr_t>,
+             typename FutureConverterInternal::TargetTypeExtractor<FixedConverter>::Type,
+             Target>>
+[[nodiscard]] QFuture<SelectedTarget> convertFuture(QObject* context,
+                              const QFuture<Source>& srcFuture,
+                              ConverterFlags flags,
+                              const Converter& converter)
+{
+    return convertFuture<Source, Target>(context, srcFuture, flags, nullptr, converter);
 }
 
 template<typename Source, typename Target = std::nullptr_t, typename Converter,
@@ -270,4 +384,91 @@ template<typename Source, typename Target = std::nullptr_t, typename Converter,
     return convertFuture<Source, Target>(context, srcFuture, {}, converter);
 }
 
+template<typename Source, typename Current, typename Fused = FutureConverterInternal::IdentityStage>
+class ConverterChain
+{
+public:
+    ConverterChain(QObject* context, const QFuture<Source>& srcFuture, ConverterFlags flags, QThreadPool* threadPool, Fused fused = {})
+        : m_context(context),
+          m_srcFuture(srcFuture),
+          m_flags(flags),
+          m_threadPool(threadPool),
+          m_fused(std::move(fused))
+    { }
+
+    template<typename F>
+    [[nodiscard]] auto map(F f) const
+    {
+        using namespace FutureConverterInternal;
+
+        if constexpr (std::is_same_v<Fused, IdentityStage>) {
+            using Next = typename FirstStageResult<Source, F>::Type;
+
+            // First stage gets reference to the result stored in source future
+            auto fused = [f](const auto&... source) mutable {
+                return invokeStage(f, source...);
+            };
+
+            return ConverterChain<Source, Next, decltype(fused)>(m_context, m_srcFuture, m_flags, m_threadPool, std::move(fused));
+        } else {
+            using Next = StageResult<F, Current&&>;
+
+            auto fused = [prev = m_fused, f](const auto&... source) mutable -> std::optional<Next> {
+                auto value = prev(source...);
+                if (!value) return std::nullopt;
+                return invokeStage(f, std::move(*value));
+            };
+
+            return ConverterChain<Source, Next, decltype(fused)>(m_context, m_srcFuture, m_flags, m_threadPool, std::move(fused));
+        }
+    }
+
+    template<typename Predicate>
+    [[nodiscard]] auto filter(Predicate predicate) const
+    {
+        static_assert(!std::is_void_v<Current>, "Nothing to filter");
+
+        if constexpr (std::is_same_v<Fused, FutureConverterInternal::IdentityStage>) {
+            auto fused = [predicate](const Source& source) mutable -> std::optional<Current> {
+                if (!predicate(source)) return std::nullopt;
+                return source;
+            };
+
+            return ConverterChain<Source, Current, decltype(fused)>(m_context, m_srcFuture, m_flags, m_threadPool, std::move(fused));
+        } else {
+            auto fused = [prev = m_fused, predicate](const auto&... source) mutable -> std::optional<Current> {
+                auto value = prev(source...);
+                if (!value || !predicate(std::as_const(*value))) return std::nullopt;
+                return value;
+            };
+
+            return ConverterChain<Source, Current, decltype(fused)>(m_context, m_srcFuture, m_flags, m_threadPool, std::move(fused));
+        }
+    }
+
+    [[nodiscard]] QFuture<Current> execute() const
+    {
+        static_assert(!std::is_same_v<Fused, FutureConverterInternal::IdentityStage>, "Chain has no stages");
+
+        using Converter = typename FutureConverterInternal::ConverterType<Source, Current>::Converter;
+        return FutureConverterInternal::startConversion<Source, Current>(m_context, m_srcFuture, m_flags, m_threadPool, Converter(m_fused));
+    }
+
+private:
+    QObject* m_context;
+    QFuture<Source> m_srcFuture;
+    ConverterFlags m_flags;
+    QThreadPool* m_threadPool;
+    Fused m_fused;
+};
+
+template<typename Source>
+[[nodiscard]] ConverterChain<Source, Source> convertChain(QObject* context,
+                                                          const QFuture<Source>& srcFuture,
+                                                          ConverterFlags flags = {},
+                                                          QThreadPool* threadPool = nullptr)
+{
+    return {context, srcFuture, flags, threadPool};
+}
+
 } // namespace UtilsQt
@@ -0,0 +1,307 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/utils-qt
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define UTILS_QT_HAS_COROUTINES 1
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <QObject>
+#include <QFuture>
+#include <QFutureWatcher>
+
+#include <UtilsQt/Futures/Utils.h>
+#include <UtilsQt/Futures/Sequential.h>
+
+/*
+          Description
+-------------------------------
+  Optional C++20 adapter, which allows to write coroutines returning QFuture<T> and to `co_await`
+  any QFuture<T> inside of them (from Promise, Sequential, mergeFutures*, signalToFuture,
+  createRetryingFuture, etc.). The header is empty, if coroutines aren't available
+  (check UTILS_QT_HAS_COROUTINES).
+
+  Example:
+   /--
+  |  QFuture<int> MyObject::loadSize(QString path) // `this` is the context
+  |  {
+  |      const QByteArray data = co_await readFileAsync(path);               // Resumed in `this` thread
+  |      const auto parsed = co_await UtilsQt::asAsyncResult(parseAsync(data)); // AsyncResult<Parsed>
+  |
+  |      if (!parsed.hasValue())
+  |          co_return -1;
+  |
+  |      co_return parsed->size();
+  |  }
+   \--
+
+  Context:
+   The first QObject among coroutine's arguments is the context (for member functions of QObject
+   descendants it's the object itself). After each `co_await` the coroutine is resumed in context's
+   thread, or in the thread where it was started if there is no context.
+   If the context is destroyed, the coroutine is destroyed at the nearest suspension point and
+   resulting future is canceled.
+
+  `co_await QFuture<T>`:
+   - returns T (nothing for QFuture<void>);
+   - rethrows exception stored in the future;
+   - if the future is canceled, the coroutine is destroyed and resulting future is canceled.
+
+  `co_await asAsyncResult(QFuture<T>)`:
+   - returns AsyncResult<T> (see Sequential.h) and never throws or cancels the coroutine.
+
+  Cancellation is bi-directional: canceling the resulting future cancels currently awaited future
+  and destroys the coroutine at the nearest suspension point.
+
+  Awaited future is watched via QFutureWatcher and isn't modified, so the same future can be awaited
+  by several coroutines and can have own continuations.
+*/
+
+namespace UtilsQt {
+
+template<typename T>
+struct AsAsyncResult
+{
+    QFuture<T> future;
+};
+
+template<typename T>
+AsAsyncResult<T> asAsyncResult(const QFuture<T>& future)
+{
+    return {future};
+}
+
+namespace FuturesCoroutineInternal {
+
+struct CoroutineState
+{
+    std::coroutine_handle<> handle;   // Empty if coroutine frame is destroyed
+    QFuture<void> awaited;            // Currently awaited future
+    bool suspended {false};
+    bool cancelRequested {false};
+
+    void resume()
+    {
+        if (!handle)
+            return;
+
+        suspended = false;
+        handle.resume();
+    }
+
+    void cancel()
+    {
+        awaited.cancel();
+
+        if (!suspended) {
+            cancelRequested = true; // Will be handled on next suspension
+            return;
+        }
+
+        if (auto h = std::exchange(handle, {}))
+            h.destroy();
+    }
+};
+
+template<typename A>
+QObject* asContext(A& arg)
+{
+    if constexpr (std::is_convertible_v<A*, QObject*>) {
+        return &arg;
+    } else if constexpr (std::is_pointer_v<A> && std::is_convertible_v<A, QObject*>) {
+        return arg;
+    } else {
+        return nullptr;
+    }
+}
+
+template<typename... Args>
+QObject* findContext(Args&... args)
+{
+    QObject* result {};
+    ((result = result ? result : asContext(args)), ...);
+    return result;
+}
+
+template<typename T, bool ReturnAsyncResult>
+class FutureAwaiter
+{
+public:
+    FutureAwaiter(const QFuture<T>& future, const std::shared_ptr<CoroutineState>& state, QObject* resumeTarget)
+        : m_future(future),
+          m_state(state),
+          m_resumeTarget(resumeTarget)
+    { }
+
+    bool await_ready() const
+    {
+        return !m_state->cancelRequested &&
+               m_future.isFinished() &&
+               (ReturnAsyncResult || !m_future.isCanceled());
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        m_state->suspended = true;
+
+        if (m_state->cancelRequested) {
+            m_state->handle = {};
+            handle.destroy(); // Destroys `this` as well
+            return;
+        }
+
+        m_state->awaited = QFuture<void>(m_future);
+
+        auto onFinished = [state = m_state, future = m_future]() {
+            state->awaited = QFuture<void>();
+
+            if (!ReturnAsyncResult && getFutureState(future) == FutureState::Canceled) {
+                state->cancel();
+            } else {
+                state->resume();
+            }
+        };
+
+        // Notice: don't touch `this` after registration, coroutine could be resumed already.
+        // QFuture::then isn't used, as a future holds single continuation and it would replace existing one.
+        auto watcher = new QFutureWatcher<void>(m_resumeTarget);
+        QObject::connect(watcher, &QFutureWatcherBase::finished, watcher, [watcher, onFinished]() {
+            watcher->deleteLater();
+            onFinished();
+        });
+        watcher->setFuture(QFuture<void>(m_future));
+    }
+
+    auto await_resume()
+    {
+        if constexpr (ReturnAsyncResult) {
+            return Futures_Seq_Internal::futureToAsyncResult(m_future);
+        } else {
+            m_future.waitForFinished(); // Rethrows stored exception
+
+            if constexpr (!std::is_same_v<T, void>)
+                return m_future.result();
+        }
+    }
+
+private:
+    QFuture<T> m_future;
+    std::shared_ptr<CoroutineState> m_state;
+    QObject* m_resumeTarget;
+};
+
+template<typename T>
+struct CoroutinePromise;
+
+template<typename T>
+class CoroutinePromiseBase
+{
+public:
+    template<typename... Args>
+    explicit CoroutinePromiseBase(Args&... args)
+    {
+        if (auto context = findContext(args...)) {
+            m_resumeTarget->moveToThread(context->thread());
+
+            QObject::connect(context, &QObject::destroyed, m_resumeTarget, [state = m_state]() {
+                state->cancel();
+            });
+        }
+
+        QObject::connect(m_resumeTarget, &QFutureWatcherBase::canceled, m_resumeTarget, [state = m_state]() {
+            state->cancel();
+        });
+
+        m_resumeTarget->setFuture(QFuture<void>(m_promise.future()));
+    }
+
+    CoroutinePromiseBase(const CoroutinePromiseBase&) = delete;
+    CoroutinePromiseBase& operator=(const CoroutinePromiseBase&) = delete;
+
+    ~CoroutinePromiseBase()
+    {
+        m_state->handle = {};
+        m_state->suspended = false;
+
+        m_resumeTarget->disconnect();
+        m_resumeTarget->deleteLater();
+    }
+
+    QFuture<T> get_return_object()
+    {
+        m_state->handle = std::coroutine_handle<CoroutinePromise<T>>::from_promise(static_cast<CoroutinePromise<T>&>(*this));
+        return m_promise.future();
+    }
+
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+
+    void unhandled_exception()
+    {
+        m_promise.finishWithException(std::current_exception());
+    }
+
+    template<typename U>
+    FutureAwaiter<U, false> await_transform(const QFuture<U>& future)
+    {
+        return {future, m_state, m_resumeTarget};
+    }
+
+    template<typename U>
+    FutureAwaiter<U, true> await_transform(const AsAsyncResult<U>& x)
+    {
+        return {x.future, m_state, m_resumeTarget};
+    }
+
+protected:
+    Promise<T> m_promise {true};
+
+private:
+    std::shared_ptr<CoroutineState> m_state { std::make_shared<CoroutineState>() };
+    QFutureWatcher<void>* m_resumeTarget { new QFutureWatcher<void>() }; // Watches resulting future
+};
+
+template<typename T>
+struct CoroutinePromise : public CoroutinePromiseBase<T>
+{
+    using CoroutinePromiseBase<T>::CoroutinePromiseBase;
+
+    void return_value(T value)
+    {
+        this->m_promise.finish(std::move(value));
+    }
+};
+
+template<>
+struct CoroutinePromise<void> : public CoroutinePromiseBase<void>
+{
+    using CoroutinePromiseBase<void>::CoroutinePromiseBase;
+
+    void return_void()
+    {
+        m_promise.finish();
+    }
+};
+
+} // namespace FuturesCoroutineInternal
+
+} // namespace UtilsQt
+
+namespace std {
+
+template<typename T, typename... Args>
+struct coroutine_traits<QFuture<T>, Args...>
+{
+    using promise_type = UtilsQt::FuturesCoroutineInternal::CoroutinePromise<T>;
+};
+
+} // namespace std
+
+#endif // defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
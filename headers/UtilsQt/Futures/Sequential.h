@@ -4,13 +4,22 @@
 
 #pragma once
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <exception>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <variant>
+#include <vector>
+
+#include <QEventLoop>
 
 #include <UtilsQt/Futures/Utils.h>
 #include <UtilsQt/Futures/Traits.h>
@@ -97,6 +106,21 @@
   |      .execute(savedAwaitables);
   \--
 
+  Parallel sub-steps are expressed with `thenAll` / `thenEach` stages:
+   /--
+  |  UtilsQt::Sequential(this)
+  |      .start(...)                                              // -> QFuture<T>
+  |      .thenAll([](const AsyncResult<T>&) -> QFuture<A> { ... },
+  |               [](const AsyncResult<T>&, SequentialMediator&) -> QFuture<B> { ... })
+  |      .then([](const AsyncResult<std::tuple<AsyncResult<A>, AsyncResult<B>>>&) { ... })
+  |      .thenEach(urls, [](const QUrl&, const AsyncResult<...>&) -> QFuture<QByteArray> { ... })
+  |      .then([](const AsyncResult<QVector<AsyncResult<QByteArray>>>&) { ... })
+  |      .execute();
+   \--
+  All branches are started at once and the stage is finished when all of them are finished.
+  Each branch reports its own result, cancellation or exception. External cancellation
+  cancels every branch future, and branches share the chain's SequentialMediator.
+
   If a future from one handler is canceled, an empty AsyncResult is passed to next handler. This
   does not cancel the entire chain by default, allowing users to produce non-canceled futures in the sequence.
 
@@ -108,8 +132,12 @@
   - Receives the AsyncResult from the previous handler (contains result, canceled state or exception).
   - Optionally receives a SequentialMediator object, which provides:
      - Cancel checking: Detect whether cancellation was requested due to external events via `SequentialMediator::isCancelRequested`.
-     - Event subscription: React to cancel events via `SequentialMediator::subscribe`.
-       (Notice! Cancellation of the resulting future and deletion of the context inside `SequentialMediator::subscribe` is prohibited).
+     - Event subscription: React to cancel events via `SequentialMediator::onCancellation`.
+       (Notice! Cancellation of the resulting future and deletion of the context inside `SequentialMediator::onCancellation` is prohibited).
+
+  `SequentialMediator::isCancelRequested` is a single atomic load, so it's fine to poll it from
+  worker threads in tight loops. Cancellation handlers are kept in a sharded registry, so concurrent
+  subscriptions from different threads rarely contend on the same lock.
 
   SequentialMediator transitions to a "canceled" state in the following scenarios:
    - When the user explicitly cancels the resulting QFuture.
@@ -135,6 +163,16 @@
      - Call `SequentialMediator::registerAwaitable` to register QFuture of true asynchronous operation.
      - Pass the `Awaitables` object via reference to `execute` method to save the `Awaitables` object.
      - Call `Awaitables::confirmWait` in destructor of context (`this`).
+
+  Awaitables API:
+   - `wait()`                   - blocks until all registered awaitables are finished.
+   - `waitFor(timeout)`         - the same, but gives up after total `timeout` (not per awaitable) and returns false.
+                                  Unfinished awaitables stay registered. Waits on the calling thread (in event loop)
+                                  via `waiter`; awaitables without `waiter` can't be interrupted and are waited
+                                  for via `expectant`.
+   - `pending()`                - lists unfinished awaitables with their description and age.
+   - `isRunning()`              - true if there is at least one unfinished awaitable.
+   Finished awaitables are pruned lazily, so registration is amortized O(1).
 */
 
 namespace UtilsQt {
@@ -149,6 +187,15 @@ public:
     {
         std::function<void()> expectant;
         std::function<bool()> checker;
+        QString description {};
+        std::function<bool(std::chrono::steady_clock::time_point)> waiter {}; // Optional, waits until finished or deadline
+        std::chrono::steady_clock::time_point registered {}; // Set on registration
+    };
+
+    struct PendingAwaitable
+    {
+        QString description;
+        std::chrono::milliseconds age;
     };
 
     Awaitables() = default;
@@ -187,10 +234,32 @@ public:
         data->wait();
     }
 
-    bool isRunning()
+    // Returns false if some awaitables aren't finished within `timeout` (total for all of them).
+    // Nothing keeps waiting after return.
+    bool waitFor(std::chrono::milliseconds timeout)
+    {
+        auto data = lock();
+        return data->waitFor(timeout);
+    }
+
+    bool isRunning() const
     {
-        auto aws = lock()->awaitables;
-        return std::any_of(aws.begin(), aws.end(), [](const AwaitableData& x) { return !x.checker || !x.checker(); });
+        const auto data = lock();
+        const auto& aws = data->awaitables;
+        return std::any_of(aws.begin(), aws.end(), [](const AwaitableData& x) { return !Data::isFinished(x); });
+    }
+
+    QVector<PendingAwaitable> pending() const
+    {
+        const auto data = lock();
+        const auto now = std::chrono::steady_clock::now();
+        QVector<PendingAwaitable> result;
+
+        for (const auto& x : data->awaitables)
+            if (!Data::isFinished(x))
+                result.append({x.description, std::chrono::duration_cast<std::chrono::milliseconds>(now - x.registered)});
+
+        return result;
     }
 
 private: // For SequentialMediator
@@ -199,10 +268,14 @@ private: // For SequentialMediator
         auto data = lock();
         assert(!data->confirmed && "Don't add `Awaitable` after `confirmWait`!");
 
-        auto& aws = data->awaitables;
-        aws.erase(std::remove_if(aws.begin(), aws.end(), [](const AwaitableData& x) { return x.checker && x.checker(); }), aws.end());
+        // Lazy pruning: sweep only when the list doubles since the last sweep
+        if (data->awaitables.size() >= data->pruneThreshold) {
+            data->prune();
+            data->pruneThreshold = std::max(Data::MinPruneThreshold, data->awaitables.size() * 2);
+        }
 
         data->awaitables += f;
+        data->awaitables.last().registered = std::chrono::steady_clock::now();
 
         return *this;
     }
@@ -219,15 +292,57 @@ private: // For SequentialMediator
 
 private:
     struct Data {
+        static constexpr decltype(QVector<AwaitableData>().size()) MinPruneThreshold = 16;
+
         const uintmax_t mainThreadId { currentThreadId() };
         QVector<AwaitableData> awaitables;
+        decltype(awaitables.size()) pruneThreshold { MinPruneThreshold };
         bool confirmed { false };
 
+        static bool isFinished(const AwaitableData& x) { return x.checker && x.checker(); }
+
+        void prune() {
+            awaitables.erase(std::remove_if(awaitables.begin(), awaitables.end(), &Data::isFinished), awaitables.end());
+        }
+
         void wait() {
             for (const auto& x : std::as_const(awaitables))
-                x.expectant();
+                if (!isFinished(x))
+                    x.expectant();
+
+            awaitables.clear();
+        }
+
+        bool waitFor(std::chrono::milliseconds timeout) {
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+            prune();
 
+            // Taken out, as new awaitables might be registered from event loop while waiting
+            auto waited = std::move(awaitables);
             awaitables.clear();
+            auto it = waited.begin();
+
+            auto restore = CreateScopedGuard([this, &waited, &it]() {
+                waited.erase(waited.begin(), it);
+                waited += awaitables;
+                awaitables = std::move(waited);
+                prune();
+            });
+
+            for (; it != waited.end(); ++it) {
+                if (isFinished(*it))
+                    continue;
+
+                if (it->waiter) {
+                    if (!it->waiter(deadline))
+                        return false;
+                } else {
+                    it->expectant(); // Can't be interrupted
+                }
+            }
+
+            return true;
         }
 
         ~Data() {
@@ -276,36 +391,44 @@ public:
 
     bool isCancelRequested() const // Called from another thread
     {
-        std::lock_guard lock(m_data->mutex);
-        return m_data->cancelRequested;
+        return m_data->cancelRequested.load(std::memory_order_acquire);
     }
 
     [[nodiscard]] auto onCancellation(const Handler& handler) const // Called from another thread
     {
-        std::lock_guard lock(m_data->mutex);
+        const auto id = m_data->ids.fetch_add(1, std::memory_order_relaxed) + 1;
 
-        auto id = ++m_data->ids;
-        assert (m_data->handlers.find(id) == m_data->handlers.end());
+        {
+            auto& shard = m_data->shardFor(id);
+            std::lock_guard lock(shard.mutex);
+            assert(shard.handlers.find(id) == shard.handlers.end());
+            shard.handlers.emplace(id, handler);
+        }
 
-        auto unsubscribeGuard = CreateScopedGuard([this, id](){
-            std::lock_guard lock(m_data->mutex);
-            m_data->handlers.erase(id);
+        return CreateScopedGuard([data = m_data, id](){
+            auto& shard = data->shardFor(id);
+            std::lock_guard lock(shard.mutex);
+            shard.handlers.erase(id);
         });
-
-        m_data->handlers[id] = handler;
-        return unsubscribeGuard;
     }
 
     template<typename T>
-    void registerAwaitable(QFuture<T> f)
+    void registerAwaitable(QFuture<T> f, const QString& description = {})
     {
-        registerAwaitable([f]() mutable { f.waitForFinished(); },
-                          [f]() { return f.isFinished(); });
+        registerAwaitable(AwaitableData{[f]() mutable { f.waitForFinished(); },
+                                        [f]() { return f.isFinished(); },
+                                        description,
+                                        [f](std::chrono::steady_clock::time_point deadline) {
+                                            const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+                                            if (remaining.count() > 0)
+                                                waitForFuture<QEventLoop>(f, static_cast<unsigned>(remaining.count()));
+                                            return f.isFinished();
+                                        }});
     }
 
-    void registerAwaitable(const std::function<void()>& expectant, const std::function<bool()>& checker)
+    void registerAwaitable(const std::function<void()>& expectant, const std::function<bool()>& checker, const QString& description = {})
     {
-        registerAwaitable(AwaitableData{expectant, checker});
+        registerAwaitable(AwaitableData{expectant, checker, description});
     }
 
     void registerAwaitable(const AwaitableData& f)
@@ -316,19 +439,19 @@ public:
 private: // For Executor
     void cancel()
     {
-        decltype(m_data->handlers) handlersCopy;
+        if (m_data->cancelRequested.exchange(true, std::memory_order_acq_rel))
+            return;
 
-        {
-            std::lock_guard lock(m_data->mutex);
+        std::vector<Handler> handlersCopy;
 
-            if (m_data->cancelRequested)
-                return;
+        for (auto& shard : m_data->shards) {
+            std::lock_guard lock(shard.mutex);
 
-            m_data->cancelRequested = true;
-            handlersCopy = m_data->handlers;
+            for (const auto& [_, handler] : shard.handlers)
+                handlersCopy.push_back(handler);
         }
 
-        for (const auto& [_, handler] : handlersCopy)
+        for (const auto& handler : handlersCopy)
             handler();
     }
 
@@ -344,11 +467,19 @@ private: // For Executor
     }
 
 private:
-    struct Data {
+    struct alignas(64) HandlersShard {
         std::mutex mutex;
-        bool cancelRequested {false};
-        int ids {0};
         std::unordered_map<int, Handler> handlers;
+    };
+
+    struct Data {
+        static constexpr size_t ShardsCount = 8;
+
+        HandlersShard& shardFor(int id) { return shards[static_cast<size_t>(id) % ShardsCount]; }
+
+        alignas(64) std::atomic<bool> cancelRequested {false};
+        std::atomic<int> ids {0};
+        std::array<HandlersShard, ShardsCount> shards;
         Awaitables awaitables;
     };
 
@@ -429,6 +560,154 @@ struct Settings
     SequentialOptions options {Default};
 };
 
+template<typename T>
+AsyncResult<T> futureToAsyncResult(QFuture<T>& future)
+{
+    assert(future.isFinished() && "We should get here only when future is finished!");
+
+    // Future can contain exception (and thus be cancelled as well).
+    // So check for exception first.
+    try {
+        future.waitForFinished(); // throws
+    } catch (...) {
+        return AsyncResult<T> {std::current_exception()};
+    }
+
+    // Check cancelled and possible result
+    if constexpr (std::is_same_v<T, void>) {
+        return future.isCanceled() ? AsyncResult<T>() :
+                                     AsyncResult<T> {VoidType()};
+    } else {
+        return future.isCanceled() ? AsyncResult<T>() :
+                                     AsyncResult<T> {future.result()};
+    }
+}
+
+// Finishes with `collector()` result when all branches are finished.
+// Cancellation of resulting future cancels all branches.
+template<typename R>
+class ParallelJoin : public QObject
+{
+    NO_COPY_MOVE(ParallelJoin);
+public:
+    ParallelJoin(const QVector<QFuture<void>>& branches, std::function<R()>&& collector)
+        : m_branches(branches),
+          m_collector(std::move(collector))
+    {
+        QObject::connect(&m_resultWatcher, &QFutureWatcherBase::canceled, this, &ParallelJoin::cancelBranches);
+        m_resultWatcher.setFuture(QFuture<void>(m_promise.future()));
+
+        for (const auto& x : std::as_const(m_branches)) {
+            if (x.isFinished()) {
+                m_finishedCnt++;
+                continue;
+            }
+
+            auto watcher = new QFutureWatcher<void>(this);
+            QObject::connect(watcher, &QFutureWatcherBase::finished, this, &ParallelJoin::onBranchFinished);
+            watcher->setFuture(x);
+        }
+
+        checkFinished();
+    }
+
+    QFuture<R> future() const { return m_promise.future(); }
+
+private:
+    void onBranchFinished()
+    {
+        m_finishedCnt++;
+        checkFinished();
+    }
+
+    void checkFinished()
+    {
+        if (m_finishedCnt < m_branches.size() || m_promise.isFinished())
+            return;
+
+        if (m_promise.isCanceled()) {
+            m_promise.cancel();
+        } else {
+            m_promise.finish(m_collector());
+        }
+
+        deleteLater();
+    }
+
+    void cancelBranches()
+    {
+        for (auto& x : m_branches)
+            x.cancel();
+    }
+
+private:
+    QVector<QFuture<void>> m_branches;
+    std::function<R()> m_collector;
+    Promise<R> m_promise {true};
+    QFutureWatcher<void> m_resultWatcher;
+    int m_finishedCnt {};
+};
+
+// std::tuple<QFuture<Ts>...>  ->  std::tuple<AsyncResult<Ts>...>
+template<typename T>
+struct AsyncResults;
+
+template<typename... Ts>
+struct AsyncResults<std::tuple<QFuture<Ts>...>>
+{
+    using Type = std::tuple<AsyncResult<Ts>...>;
+};
+
+// Calls branch handler of `thenAll` / `thenEach` stage.
+// SequentialMediator is passed only if handler accepts it.
+// Exception thrown by handler is stored into returned future.
+template<typename F, typename... Args>
+auto callBranch(F& f, SequentialMediator& sm, const Args&... args)
+{
+    auto call = [&]() {
+        if constexpr (std::is_invocable_v<F&, const Args&..., SequentialMediator&>) {
+            return f(args..., sm);
+        } else {
+            return f(args...);
+        }
+    };
+
+    using R = typename QFutureUnwrap<decltype(call())>::type;
+
+    try {
+        return call();
+    } catch (...) {
+        return createExceptionFuture<R>(std::current_exception());
+    }
+}
+
+// Types of the QFuture returned by I-th handler and of its payload
+template<typename Tuple, size_t I>
+struct StepTraits
+{
+    using PrevAsyncResult = AsyncResult<typename StepTraits<Tuple, I - 1>::Result>;
+    using Future = std::invoke_result_t<std::tuple_element_t<I, Tuple>&, PrevAsyncResult&, SequentialMediator&>;
+    using Result = typename QFutureUnwrap<Future>::type;
+};
+
+template<typename Tuple>
+struct StepTraits<Tuple, 0>
+{
+    using Future = std::invoke_result_t<std::tuple_element_t<0, Tuple>&, SequentialMediator&>;
+    using Result = typename QFutureUnwrap<Future>::type;
+};
+
+// std::variant<std::monostate, QFuture<T0>, QFuture<T1>, ...>.
+// I-th step future is stored at index I + 1.
+template<typename Tuple, typename Indexes = std::make_index_sequence<std::tuple_size_v<Tuple>>>
+struct StepFutures;
+
+template<typename Tuple, size_t... Is>
+struct StepFutures<Tuple, std::index_sequence<Is...>>
+{
+    using Type = std::variant<std::monostate, typename StepTraits<Tuple, Is>::Future...>;
+};
+
 template<typename... Fs>
 class Executor : public QObject
 {
@@ -447,8 +726,15 @@ public:
         if (m_settings.context)
             QObject::connect(m_settings.context, &QObject::destroyed, this, [this](){ cancel(); });
 
-        UtilsQt::onCancelNotified(m_promise.future(), this, [this](){ cancel(); });
-        UtilsQt::onFinishedNoParamNoExcept(m_promise.future(), this, &QObject::deleteLater);
+        // Single watcher is reused for all not-yet-finished step futures
+        QObject::connect(&m_stepWatcher, &QFutureWatcherBase::finished, this, [this](){
+            if (m_onStepFinished)
+                (this->*m_onStepFinished)();
+        });
+
+        QObject::connect(&m_promiseWatcher, &QFutureWatcherBase::canceled, this, [this](){ cancel(); });
+        QObject::connect(&m_promiseWatcher, &QFutureWatcherBase::finished, this, &QObject::deleteLater);
+        m_promiseWatcher.setFuture(QFuture<void>(m_promise.future()));
     }
 
     template<size_t I, typename... Args>
@@ -480,17 +766,15 @@ public:
                 if constexpr (std::is_same_v<LastFuncResult, void>) {
                     m_promise.finish();
                 } else {
-                    m_promise.finish(lastAsyncResult.value());
+                    m_promise.finish(std::move(lastAsyncResult.value()));
                 }
             }
 
             // return;
 
         } else { // I < Length
-            using Func = std::tuple_element_t<I, Tuple>;                           // []([const T&]?, SequentialMediator&) -> QFuture<T> {}
-            using Ret = std::invoke_result_t<Func, Args..., SequentialMediator&>;  // QFuture<T>
-            using T = typename QFutureUnwrap<Ret>::type;                           // T
-            using QFutureT = Ret;
+            using QFutureT = typename StepTraits<Tuple, I>::Future; // QFuture<T>
+            using T = typename StepTraits<Tuple, I>::Result;        // T
 
             // Report start
             if constexpr (I == 0) {
@@ -515,48 +799,25 @@ public:
             }
 
             std::exception_ptr eptr;
-            QFutureT fResult;
+            std::optional<QFutureT> fResult;
 
             try {
-                fResult = std::get<I>(m_handlers)(args..., m_sequentialMediator);
-
-                if (!fResult.isFinished())
-                    m_futures.append(QFuture<void>(fResult));
-
+                fResult.emplace(std::get<I>(m_handlers)(args..., m_sequentialMediator));
             } catch (...) {
                 eptr = std::current_exception();
             }
 
             if (eptr) {
-                AsyncResult<T> asyncResult {eptr};
-                call<I + 1>(std::move(asyncResult));
+                call<I + 1>(AsyncResult<T> {std::move(eptr)});
+
+            } else if (fResult->isFinished()) {
+                // Already done, so there is nothing to wait for
+                call<I + 1>(futureToAsyncResult(*fResult));
 
             } else {
-                auto futureToResult = [fResult]() mutable {
-                    assert(fResult.isFinished() && "We should get here only when future is finished!");
-
-                    // Future can contain exception (and thus be cancelled as well).
-                    // So check for exception first.
-                    try {
-                        fResult.waitForFinished(); // throws
-                    } catch (...) {
-                        return AsyncResult<T> {std::current_exception()};
-                    }
-
-                    // Check cancelled and possible result
-                    if constexpr (std::is_same_v<T, void>) {
-                        return fResult.isCanceled() ? AsyncResult<T>() :
-                                                      AsyncResult<T> {VoidType()};
-                    } else {
-                        return fResult.isCanceled() ? AsyncResult<T>() :
-                                                      AsyncResult<T> {fResult.result()};
-                    }
-                };
-
-                UtilsQt::onFinishedNoParamNoExcept(fResult, this, [this, futureToResult]() mutable {
-                    auto asyncResult = futureToResult();
-                    call<I + 1>(std::move(asyncResult));
-                });
+                m_stepFuture.template emplace<I + 1>(std::move(*fResult));
+                m_onStepFinished = &Executor::onStepFinished<I>;
+                m_stepWatcher.setFuture(QFuture<void>(std::get<I + 1>(m_stepFuture)));
             }
         } // if constexpr (I == Length), else
     }
@@ -583,16 +844,31 @@ public:
         if (!m_promise.isFinished())
             m_promise.cancel();
 
-        for (auto& f : m_futures)
-            f.cancel();
+        // Only the current step can be running, previous ones are finished already
+        m_stepWatcher.future().cancel();
+    }
+
+private:
+    template<size_t I>
+    void onStepFinished()
+    {
+        // Take the future out, as next step could overwrite `m_stepFuture`
+        auto fResult = std::get<I + 1>(m_stepFuture);
+        m_stepFuture = std::monostate();
+        m_onStepFinished = nullptr;
+
+        call<I + 1>(futureToAsyncResult(fResult));
     }
 
 private:
     Settings m_settings;
     Tuple m_handlers;
-    QVector<QFuture<void>> m_futures;
     SequentialMediator m_sequentialMediator;
     Promise<LastFuncResult> m_promise;
+    QFutureWatcher<void> m_promiseWatcher;
+    typename StepFutures<Tuple>::Type m_stepFuture;
+    QFutureWatcher<void> m_stepWatcher;
+    void (Executor::* m_onStepFinished)() {};
 };
 
 template<typename T, typename... Fs>
@@ -617,6 +893,60 @@ public:
         return thenImpl(std::forward<F>(f), Func());
     }
 
+    // Fan-out / fan-in stage. Each handler accepts `const AsyncResult<T>&` and optionally
+    // `SequentialMediator`, like regular `then` handlers. All of them are called at once,
+    // and next stage receives `AsyncResult<std::tuple<AsyncResult<R1>, AsyncResult<R2>, ...>>`.
+    template<typename... Hs>
+    [[nodiscard]] auto thenAll(Hs&&... hs)
+    {
+        static_assert(sizeof...(Hs) > 0, "At least one handler is required!");
+
+        return then([hs = std::make_tuple(std::forward<Hs>(hs)...)](const AsyncResult<T>& ar, SequentialMediator& sm) mutable {
+            auto futures = std::apply([&](auto&... xs){ return std::make_tuple(callBranch(xs, sm, ar)...); }, hs);
+            using Joined = typename AsyncResults<decltype(futures)>::Type;
+
+            const auto branches = std::apply([](const auto&... xs){ return QVector<QFuture<void>> {QFuture<void>(xs)...}; }, futures);
+            auto join = new ParallelJoin<Joined>(branches, [futures]() mutable {
+                return std::apply([](auto&... xs){ return Joined(futureToAsyncResult(xs)...); }, futures);
+            }); // "detached" lifetime
+
+            return join->future();
+        });
+    }
+
+    // Fan-out / fan-in stage over container. Handler accepts `const Item&`, `const AsyncResult<T>&`
+    // and optionally `SequentialMediator`. It's called for each item at once,
+    // and next stage receives `AsyncResult<QVector<AsyncResult<R>>>` in order of items.
+    template<typename Container, typename F>
+    [[nodiscard]] auto thenEach(const Container& items, F&& f)
+    {
+        return then([items, f = std::forward<F>(f)](const AsyncResult<T>& ar, SequentialMediator& sm) mutable {
+            using Item = std::decay_t<decltype(*std::begin(items))>;
+            using R = typename QFutureUnwrap<decltype(callBranch(f, sm, std::declval<const Item&>(), ar))>::type;
+            using Joined = QVector<AsyncResult<R>>;
+
+            QVector<QFuture<R>> futures;
+            QVector<QFuture<void>> branches;
+
+            for (const auto& x : items) {
+                futures.append(callBranch(f, sm, x, ar));
+                branches.append(QFuture<void>(futures.last()));
+            }
+
+            auto join = new ParallelJoin<Joined>(branches, [futures]() mutable {
+                Joined result;
+                result.reserve(futures.size());
+
+                for (auto& x : futures)
+                    result.append(futureToAsyncResult(x));
+
+                return result;
+            }); // "detached" lifetime
+
+            return join->future();
+        });
+    }
+
     [[nodiscard]] QFuture<T> execute()
     {
         auto executor = new Executor(std::move(m_settings), std::move(m_handlers)); // "detached" lifetime
@@ -5,9 +5,14 @@
 #pragma once
 #include <UtilsQt/Futures/Utils.h>
 #include <QObject>
+#include <QVector>
+#include <array>
 #include <chrono>
+#include <functional>
+#include <memory>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 /*  Overview
  *
@@ -21,36 +26,113 @@
  *    0  - QFuture<void>
  *    1  - QFuture<T>
  *    2+ - QFuture<std::tuple<Args...>>
+ *
+ *  And there is function which collects several emissions into one QFuture<QVector<Item>>:
+ *    auto f = signalToStream(&obj, &Class::someSignal, 10);                  // First 10 emissions
+ *    auto f = signalToStream(&obj, &Class::someSignal, 0, this, 100ms);      // Everything emitted during 100 ms
+ *    auto f = signalToStream(&obj, &Class::someSignal, [](const Item& x) { return x.isLast; }); // Until predicate holds
+ *
+ *  Item type depends on signal parameters count and types:
+ *    0  - std::tuple<>
+ *    1  - T
+ *    2+ - std::tuple<Args...>
+ *
+ *  Stream is finished when `count` emissions are collected (0 - unlimited), when predicate returns
+ *  true (that emission is included) or when timeout elapses (with items collected so far).
+ *  Both functions cancel the future if `object` or `context` is destroyed first.
+ *
+ *  Internal contexts are taken from small per-thread pool and returned back when the future is
+ *  finished, so waiting for bursts of signals doesn't allocate new QObject per call.
  */
 
 namespace UtilsQt {
 
 namespace Internal {
 
-void deleteAfter(QObject* object, std::chrono::milliseconds timeout);
+// Reusable receiver for signalToFuture / signalToStream connections.
+// `generation` is incremented on each release, so stale queued calls and timers are ignored.
+class SignalContext : public QObject
+{
+public:
+    quint64 generation {};
+    std::array<QMetaObject::Connection, 3> connections;
+};
+
+SignalContext* acquireSignalContext();
+void releaseSignalContext(SignalContext* ctx);
+void callAfter(QObject* ctx, std::chrono::milliseconds timeout, const std::function<void()>& func);
 
 template<size_t Count, typename... Args>
 struct ResultProviderImpl {
     using ReturnType = std::tuple<std::remove_cv_t<std::remove_reference_t<Args>>...>;
+    using ItemType = ReturnType;
 
     static void apply(Promise<ReturnType>& promise, const Args&... args) { promise.finish({args...}); }
+    static ItemType makeItem(const Args&... args) { return {args...}; }
 };
 
 template<typename T>
 struct ResultProviderImpl<1, T> {
     using ReturnType = std::remove_cv_t<std::remove_reference_t<T>>;
+    using ItemType = ReturnType;
+
     static void apply(Promise<ReturnType>& promise, const T& arg) { promise.finish(arg); }
+    static ItemType makeItem(const T& arg) { return arg; }
 };
 
 template<>
 struct ResultProviderImpl<0> {
     using ReturnType = void;
+    using ItemType = std::tuple<>;
+
     static void apply(Promise<ReturnType>& promise) { promise.finish(); }
+    static ItemType makeItem() { return {}; }
 };
 
 template<typename... Args>
 struct ResultProvider : public ResultProviderImpl<sizeof...(Args), Args...> { };
 
+template<typename Object, typename... Args, typename StopCondition,
+         typename Item = typename ResultProvider<Args...>::ItemType>
+QFuture<QVector<Item>> signalToStream(Object* object, void (Object::* signal)(Args...), StopCondition stop, QObject* context, std::chrono::milliseconds timeout)
+{
+    assert(timeout.count() >= 0);
+
+    auto promise = UtilsQt::createPromise<QVector<Item>>(true);
+    auto items = std::make_shared<QVector<Item>>();
+    auto ctx = acquireSignalContext();
+    const auto generation = ctx->generation;
+
+    auto finish = [promise, items, ctx, generation](bool canceled) mutable {
+        if (ctx->generation != generation) return;
+
+        if (!promise.isFinished()) {
+            if (canceled) {
+                promise.cancel();
+            } else {
+                promise.finish(std::move(*items));
+            }
+        }
+
+        releaseSignalContext(ctx);
+    };
+
+    ctx->connections[0] = QObject::connect(object, signal, ctx, [items, stop, finish, ctx, generation](Args... args) mutable {
+        if (ctx->generation != generation) return;
+
+        items->append(ResultProvider<Args...>::makeItem(args...));
+        if (stop(*items)) finish(false);
+    });
+
+    ctx->connections[1] = QObject::connect(object, &QObject::destroyed, ctx, [finish]() mutable { finish(true); });
+    if (context) ctx->connections[2] = QObject::connect(context, &QObject::destroyed, ctx, [finish]() mutable { finish(true); });
+
+    if (timeout.count() > 0) {
+        callAfter(ctx, timeout, [finish]() mutable { finish(false); });
+    }
+
+    return promise.future();
+}
 
 } // namespace Internal
 
@@ -62,22 +144,26 @@ QFuture<ResultType> signalToFuture(Object* object, void (Object::* signal)(Args.
     assert(timeout.count() >= 0);
 
     auto promise = UtilsQt::createPromise<ResultType>(true);
+    auto ctx = Internal::acquireSignalContext();
+    const auto generation = ctx->generation;
 
-    auto ctx = new QObject();
-    QObject::connect(object, &QObject::destroyed, ctx, &QObject::deleteLater);
-    if (context) QObject::connect(context, &QObject::destroyed, ctx, &QObject::deleteLater); // NOLINT(readability-suspicious-call-argument)
+    auto release = [promise, ctx, generation]() mutable {
+        if (ctx->generation != generation) return;
+        if (!promise.isFinished()) promise.cancel();
+        Internal::releaseSignalContext(ctx);
+    };
 
-    QObject::connect(object, signal, ctx, [promise, ctx](Args... args) mutable {
+    ctx->connections[0] = QObject::connect(object, signal, ctx, [promise, release, ctx, generation](Args... args) mutable {
+        if (ctx->generation != generation) return;
         if (!promise.isFinished()) Internal::ResultProvider<Args...>::apply(promise, args...);
-        ctx->deleteLater();
+        release();
     });
 
-    QObject::connect(ctx, &QObject::destroyed, [promise]() mutable {
-        if (!promise.isFinished()) promise.cancel();
-    });
+    ctx->connections[1] = QObject::connect(object, &QObject::destroyed, ctx, release);
+    if (context) ctx->connections[2] = QObject::connect(context, &QObject::destroyed, ctx, release); // NOLINT(readability-suspicious-call-argument)
 
     if (timeout.count() > 0) {
-        Internal::deleteAfter(ctx, timeout);
+        Internal::callAfter(ctx, timeout, release);
     }
 
     return promise.future();
@@ -91,4 +177,27 @@ QFuture<ResultType> signalToFuture(Object* object, void (Object::* signal)(Args.
     return signalToFuture(object, signal, context, std::chrono::milliseconds(timeout));
 }
 
+template<typename Object, typename... Args,
+         typename Item = typename Internal::ResultProvider<Args...>::ItemType,
+         typename std::enable_if<std::is_base_of<QObject, Object>::value>::type* = nullptr>
+QFuture<QVector<Item>> signalToStream(Object* object, void (Object::* signal)(Args...), int count, QObject* context = nullptr, std::chrono::milliseconds timeout = {})
+{
+    assert(count >= 0);
+
+    return Internal::signalToStream(object, signal, [count](const QVector<Item>& items) {
+        return count > 0 && items.size() >= count;
+    }, context, timeout);
+}
+
+template<typename Object, typename... Args, typename Predicate,
+         typename Item = typename Internal::ResultProvider<Args...>::ItemType,
+         typename std::enable_if<std::is_base_of<QObject, Object>::value &&
+                                 std::is_invocable_r<bool, Predicate, const Item&>::value>::type* = nullptr>
+QFuture<QVector<Item>> signalToStream(Object* object, void (Object::* signal)(Args...), Predicate predicate, QObject* context = nullptr, std::chrono::milliseconds timeout = {})
+{
+    return Internal::signalToStream(object, signal, [predicate](const QVector<Item>& items) mutable {
+        return predicate(items.last());
+    }, context, timeout);
+}
+
 } // namespace UtilsQt
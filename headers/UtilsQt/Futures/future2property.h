@@ -7,8 +7,13 @@
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QTimer>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <type_traits>
+#include <utility>
 
 
 namespace Internal {
@@ -150,3 +155,260 @@ void future2property(const QObject* context,
 {
     future2property(context, dataGetter, propSetter, [](){}, errorHandler, retryCount, timeout, retryInterval);
 }
+
+
+/*  Future2propertyBinding
+ *
+ *  Persistent alternative to future2property for properties which are refreshed repeatedly
+ *  (e.g. on each selection change). Create it once per property and call `trigger()`:
+ *
+ *    auto binding = future2propertyBinding(this,
+ *                                          [this](){ return loadDetails(m_selection); },
+ *                                          [this](const Details& x){ setDetails(x); },
+ *                                          [](){ qWarning() << "Failed to load details"; });
+ *    binding->setPacing(Future2propertyPacing::Debounce, 150);
+ *    connect(this, &MyClass::selectionChanged, binding, [binding](){ binding->trigger(); });
+ *
+ *  - Latest wins: new request cancels the in-flight one, results of stale requests are never set.
+ *  - Debounce: request is started `interval` ms after the last trigger.
+ *    Throttle: at most one request per `interval` ms, trailing trigger isn't lost.
+ *  - Timeout / retry / error handling is the same as in future2property.
+ *  - Timers and watcher are created once and reused.
+ *  - Binding is a child of `context` and cancels in-flight request when destroyed.
+ */
+
+enum class Future2propertyPacing
+{
+    None,
+    Debounce,
+    Throttle
+};
+
+struct Future2propertyMetrics
+{
+    bool inFlight {false};
+    unsigned int requests {0};   // Getter calls, including retries
+    unsigned int applied {0};    // Results passed to setter
+    unsigned int superseded {0}; // In-flight requests canceled by newer trigger
+    unsigned int failed {0};     // Error handler calls
+    std::chrono::milliseconds lastLatency {0}; // From the last trigger to applied result
+    std::chrono::milliseconds maxLatency {0};
+    std::chrono::milliseconds totalLatency {0};
+
+    std::chrono::milliseconds averageLatency() const { return applied ? totalLatency / applied : std::chrono::milliseconds(0); }
+};
+
+template<typename T>
+class Future2propertyBinding : public QObject
+{
+public:
+    using Getter = std::function<QFuture<T>()>;  // QFuture<T> func();
+    using Setter = std::function<void(const T&)>; // void func(const T& value);
+    using Handler = std::function<void()>;        // void func();
+
+    Future2propertyBinding(QObject* context,
+                           const Getter& dataGetter,
+                           const Setter& propSetter,
+                           const Handler& errorHandler,
+                           unsigned int retryCount = 3,
+                           unsigned int timeout = 2000,
+                           unsigned int retryInterval = 100)
+        : QObject(context),
+          m_dataGetter(dataGetter),
+          m_propSetter(propSetter),
+          m_errorHandler(errorHandler),
+          m_retryCount(retryCount),
+          m_timeout(timeout),
+          m_retryInterval(retryInterval)
+    {
+        m_timeoutTimer.setSingleShot(true);
+        m_timeoutTimer.setInterval(timeout);
+        m_retryTimer.setSingleShot(true);
+        m_retryTimer.setInterval(retryInterval);
+        m_pacingTimer.setSingleShot(true);
+
+        QObject::connect(&m_timeoutTimer, &QTimer::timeout, this, [this](){ onTimeout(); });
+        QObject::connect(&m_retryTimer, &QTimer::timeout, this, [this](){ request(); });
+        QObject::connect(&m_pacingTimer, &QTimer::timeout, this, [this](){ onPacingTimeout(); });
+        QObject::connect(&m_watcher, &QFutureWatcherBase::finished, this, [this](){ onFinished(); });
+    }
+
+    ~Future2propertyBinding() override {
+        cancel();
+    }
+
+    void setTimeoutHandler(const Handler& timeoutHandler) { m_timeoutHandler = timeoutHandler; }
+
+    void setPacing(Future2propertyPacing pacing, unsigned int interval) {
+        m_pacing = pacing;
+        m_pacingTimer.stop();
+        m_pacingTimer.setInterval(interval);
+        m_throttledTrigger = false;
+    }
+
+    void trigger() {
+        m_sinceTrigger.start();
+
+        switch (m_pacing) {
+            case Future2propertyPacing::None:
+                start();
+                break;
+
+            case Future2propertyPacing::Debounce:
+                m_pacingTimer.start();
+                break;
+
+            case Future2propertyPacing::Throttle:
+                if (m_pacingTimer.isActive()) {
+                    m_throttledTrigger = true;
+                } else {
+                    start();
+                    m_pacingTimer.start();
+                }
+                break;
+        }
+    }
+
+    void cancel() {
+        m_pacingTimer.stop();
+        m_retryTimer.stop();
+        m_timeoutTimer.stop();
+        m_throttledTrigger = false;
+        cancelInFlight();
+    }
+
+    bool isInFlight() const { return m_metrics.inFlight; }
+    const Future2propertyMetrics& metrics() const { return m_metrics; }
+
+private:
+    // New logical request, replaces current one
+    void start() {
+        m_retryTimer.stop();
+
+        if (m_metrics.inFlight)
+            m_metrics.superseded++;
+
+        cancelInFlight();
+        m_retriesLeft = m_retryCount;
+        request();
+    }
+
+    void request() {
+        auto future = m_dataGetter();
+
+        m_metrics.requests++;
+        m_metrics.inFlight = true;
+
+        if (m_timeout)
+            m_timeoutTimer.start();
+
+        m_watcher.setFuture(future);
+    }
+
+    void cancelInFlight() {
+        if (!m_metrics.inFlight)
+            return;
+
+        m_metrics.inFlight = false;
+        m_timeoutTimer.stop();
+        m_watcher.future().cancel();
+    }
+
+    void onFinished() {
+        // Notification of replaced future could be already posted, when watcher gets the new one.
+        // It's ignored if the new future isn't finished yet, otherwise result is the current one anyway.
+        const auto future = m_watcher.future();
+
+        if (!m_metrics.inFlight || !future.isFinished())
+            return; // Canceled, timed out or replaced
+
+        m_metrics.inFlight = false;
+        m_timeoutTimer.stop();
+
+        if (future.isCanceled() || future.resultCount() == 0) {
+            retryOrFail();
+            return;
+        }
+
+        const auto latency = std::chrono::milliseconds(m_sinceTrigger.elapsed());
+        m_metrics.applied++;
+        m_metrics.lastLatency = latency;
+        m_metrics.maxLatency = std::max(m_metrics.maxLatency, latency);
+        m_metrics.totalLatency += latency;
+
+        m_propSetter(future.result());
+    }
+
+    void onTimeout() {
+        if (!m_metrics.inFlight)
+            return;
+
+        cancelInFlight();
+
+        if (m_timeoutHandler)
+            m_timeoutHandler();
+
+        retryOrFail();
+    }
+
+    void retryOrFail() {
+        if (m_retriesLeft) {
+            m_retriesLeft--;
+
+            if (m_retryInterval) {
+                m_retryTimer.start();
+            } else {
+                request();
+            }
+        } else {
+            m_metrics.failed++;
+            m_errorHandler();
+        }
+    }
+
+    void onPacingTimeout() {
+        if (m_pacing == Future2propertyPacing::Debounce) {
+            start();
+        } else if (m_throttledTrigger) {
+            m_throttledTrigger = false;
+            start();
+            m_pacingTimer.start();
+        }
+    }
+
+private:
+    Getter m_dataGetter;
+    Setter m_propSetter;
+    Handler m_timeoutHandler;
+    Handler m_errorHandler;
+
+    unsigned int m_retryCount;
+    unsigned int m_timeout;
+    unsigned int m_retryInterval;
+    unsigned int m_retriesLeft {0};
+
+    Future2propertyPacing m_pacing {Future2propertyPacing::None};
+    bool m_throttledTrigger {false};
+
+    QTimer m_timeoutTimer;
+    QTimer m_retryTimer;
+    QTimer m_pacingTimer;
+    QFutureWatcher<T> m_watcher;
+    QElapsedTimer m_sinceTrigger;
+    Future2propertyMetrics m_metrics;
+};
+
+
+template<typename Getter, typename Setter, typename ErrorHandler,
+         typename Type = decltype(std::declval<std::invoke_result_t<Getter>>().result())>
+Future2propertyBinding<Type>* future2propertyBinding(QObject* context,
+                                                     const Getter& dataGetter,         // QFuture<T> func();
+                                                     const Setter& propSetter,         // void func(const T& value);
+                                                     const ErrorHandler& errorHandler, // void func();
+                                                     unsigned int retryCount = 3,
+                                                     unsigned int timeout = 2000,
+                                                     unsigned int retryInterval = 100
+                                                     )
+{
+    return new Future2propertyBinding<Type>(context, dataGetter, propSetter, errorHandler, retryCount, timeout, retryInterval);
+}
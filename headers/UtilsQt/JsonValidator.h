@@ -9,18 +9,49 @@
 #include <QJsonValue>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QHash>
 
+#include <cassert>
 #include <vector>
+#include <unordered_set>
 #include <memory>
 #include <optional>
 #include <functional>
 
 #include <utils-cpp/default_ctor_ops.h>
 #include <utils-cpp/variadic_tools.h>
+#include <utils-cpp/pimpl.h>
+
+class QIODevice;
+class QThreadPool;
 
 namespace UtilsQt {
 namespace JsonValidator {
 
+// Current location in the document as a stack of keys and indexes.
+// Keys aren't copied, so they should outlive the Path (they're owned by validators).
+// Converted to string (e.g. "/items[3]/name") only when an error is reported.
+class Path
+{
+public:
+    void pushKey(const QString& key) { m_segments.push_back({&key, 0}); }
+    void pushIndex(int index) { m_segments.push_back({nullptr, index}); }
+    void setIndex(int index) { assert(!m_segments.empty() && !m_segments.back().key); m_segments.back().index = index; }
+    void pop() { assert(!m_segments.empty()); m_segments.pop_back(); }
+
+    bool isEmpty() const { return m_segments.empty(); }
+    QString toString() const;
+
+private:
+    struct Segment
+    {
+        const QString* key {}; // nullptr for array index
+        int index {};
+    };
+
+    std::vector<Segment> m_segments;
+};
+
 class ErrorInfo
 {
 public:
@@ -30,6 +61,7 @@ public:
     virtual ~ErrorInfo() = default;
 
     void notifyError(const QString& path, const QString& error);
+    void notifyError(const Path& path, const QString& error) { notifyError(path.toString(), error); }
     void clear();
 
     bool hasError() const { return m_hasError; }
@@ -53,7 +85,41 @@ protected:
 };
 
 
-using ContextData = QVariantMap;
+namespace Internal {
+
+class Compiler;
+class ContextLists;
+
+// Consistent with QJsonValue::operator==
+struct JsonValueHash
+{
+    size_t operator()(const QJsonValue& value) const;
+};
+
+using JsonValueSet = std::unordered_set<QJsonValue, JsonValueHash>;
+
+} // namespace Internal
+
+// Values shared by Ctx* validators during a check. Lists filled by CtxAppendToList are QVariantLists,
+// hashed indexes are kept alongside (and rebuilt if a list is replaced), so in-list checks are O(1).
+class ContextData : public QVariantMap
+{
+public:
+    using QVariantMap::QVariantMap;
+    ContextData() = default;
+    ContextData(const QVariantMap& values): QVariantMap(values) { }
+
+private:
+    friend class Internal::ContextLists;
+
+    struct ListIndex
+    {
+        QVariantList list; // Shares indexed list data: it can't be reused by another list and is detached on external change
+        Internal::JsonValueSet values;
+    };
+
+    QHash<QString, ListIndex> m_listIndexes;
+};
 
 class Validator;
 using ValidatorCPtr = std::shared_ptr<const Validator>;
@@ -70,13 +136,14 @@ public:
     { }
 
     virtual ~Validator() = default;
-    virtual bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const = 0;
+    virtual bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const = 0;
 
 protected:
-    bool checkNested(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const;
+    bool checkNested(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const;
     const std::vector<ValidatorCPtr>& nestedValidators() const { return m_validators; }
 
 private:
+    friend class Internal::Compiler;
     std::vector<ValidatorCPtr> m_validators;
 };
 
@@ -133,7 +200,7 @@ public:
     { }
 
     bool check(ErrorInfo& logger, const QJsonValue& value) const;
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
 };
 
 using RootValidatorCPtr = std::shared_ptr<RootValidator>;
@@ -145,7 +212,7 @@ public:
         : Validator(validators)
     { }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
 };
 
 class Array : public Validator
@@ -155,7 +222,7 @@ public:
         : Validator(validators)
     { }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
 };
 
 class Field : public Validator
@@ -173,9 +240,10 @@ public:
           m_key(key)
     {}
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
 
 private:
+    friend class Compiler;
     bool m_optional;
     QString m_key;
 };
@@ -192,9 +260,10 @@ public:
         : Validator(validators)
     { }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
 
 private:
+    friend class Compiler;
     bool m_exclusive{false};
 };
 
@@ -204,7 +273,7 @@ public:
         : Validator(validators)
     { }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
 };
 
 class String : public Validator
@@ -236,9 +305,10 @@ public:
           m_ipv4(true)
     { }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
 
 private:
+    friend class Compiler;
     bool m_nonEmpty { false };
     bool m_hex { false };
     bool m_base64 { false };
@@ -252,7 +322,7 @@ public:
         : Validator(validators)
     { }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
 };
 
 class Number : public Validator
@@ -278,9 +348,10 @@ public:
           m_validator(std::make_unique<MinMaxValidatorInt>(min, max))
     { }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
 
 private:
+    friend class Compiler;
     bool m_isIntegerExpected {};
     std::unique_ptr<MinMaxValidator> m_validator {std::make_unique<MinMaxValidator>()};
 };
@@ -291,13 +362,13 @@ public:
     using Values = std::vector<QJsonValue>;
 
     Exclude(const Values& values)
-        : m_values(values)
+        : m_values(values.cbegin(), values.cend())
     { }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
 
 private:
-    Values m_values;
+    JsonValueSet m_values;
 };
 
 class Include : public Validator
@@ -306,36 +377,44 @@ public:
     using Values = std::vector<QJsonValue>;
 
     Include(const Values& values)
-        : m_values(values)
+        : m_values(values.cbegin(), values.cend())
     { }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
 
 private:
-    Values m_values;
+    JsonValueSet m_values;
+};
+
+// Validators, which need only the length of an array
+class ArrayLengthValidator : public Validator
+{
+public:
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
+    virtual bool checkLength(ContextData& ctx, ErrorInfo& logger, Path& path, qsizetype length) const = 0;
 };
 
-class CtxWriteArrayLength : public Validator
+class CtxWriteArrayLength : public ArrayLengthValidator
 {
 public:
     CtxWriteArrayLength(const QString& ctxField)
         : m_ctxField(ctxField)
     { }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool checkLength(ContextData& ctx, ErrorInfo& logger, Path& path, qsizetype length) const override;
 
 private:
     QString m_ctxField;
 };
 
-class CtxCheckArrayLength : public Validator
+class CtxCheckArrayLength : public ArrayLengthValidator
 {
 public:
     CtxCheckArrayLength(const QString& ctxField)
         : m_ctxField(ctxField)
     { }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool checkLength(ContextData& ctx, ErrorInfo& logger, Path& path, qsizetype length) const override;
 
 private:
     QString m_ctxField;
@@ -348,7 +427,7 @@ public:
         : m_ctxField(ctxField)
     { }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
 
 private:
     QString m_ctxField;
@@ -361,7 +440,7 @@ public:
         : m_ctxField(ctxField)
     { }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
 
 private:
     QString m_ctxField;
@@ -374,7 +453,7 @@ public:
         : m_ctxField(ctxField)
     { }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
 
 private:
     QString m_ctxField;
@@ -387,13 +466,13 @@ public:
         : m_ctxField(ctxField)
     { }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
 
 private:
     QString m_ctxField;
 };
 
-class ArrayLength : public Validator
+class ArrayLength : public ArrayLengthValidator
 {
 public:
     ArrayLength(const std::optional<size_t>& min,
@@ -408,7 +487,7 @@ public:
         : m_strictLen(strictLen)
     { }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool checkLength(ContextData& ctx, ErrorInfo& logger, Path& path, qsizetype length) const override;
 
 private:
     std::optional<size_t> m_strictLen;
@@ -425,7 +504,7 @@ public:
         assert(m_validator);
     }
 
-    bool check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const override;
+    bool check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const override;
 
 private:
     std::function<bool(const QJsonValue&)> m_validator;
@@ -433,6 +512,63 @@ private:
 
 } // namespace Internal
 
+// RootValidator compiled to a flat program: nodes are laid out in pre-order with pre-resolved
+// keys and JSON type masks, and executed by an interpreter instead of virtual calls.
+// Or/Exclusive branches which can't accept the value's JSON type are skipped without running.
+// Results and errors are the same as with RootValidator. Keeps the RootValidator alive.
+//
+// Optionally, elements of large arrays are validated in parallel (in chunks), if there are no Ctx*
+// validators under the Array. The first error in document order is reported, so results are the
+// same as in sequential mode. Notice: CustomValidator functions should be thread-safe in this mode.
+//
+// Streaming: checkUtf8/checkDevice/checkFile parse UTF-8 JSON and validate it in one pass, without
+// building QJsonDocument. Memory is proportional to nesting depth, except for values which have to be
+// checked as a whole and so are built as QJsonValue: arrays/objects under Or, CustomValidator, Ctx*
+// (except array length ones) and other leaf validators, and fields which come in the document before
+// the fields preceding them in the validator (they wait for those). Results, errors and ContextData
+// are the same as with check(QJsonDocument::fromJson(...)), except for objects with duplicate keys:
+// the first value of a key is validated and later ones are only parsed (in built values too), while
+// QJsonDocument keeps the last one (a field is validated before the rest of the object is read). Validation stops on the
+// first error, so JSON syntax is checked only up to it. Syntax errors are reported with byte offset.
+enum class FileAccess
+{
+    Read,
+    MemoryMapped  // Falls back to Read, if the file can't be mapped
+};
+
+struct ParallelOptions
+{
+    bool enabled {false};
+    int minArraySize {4096};     // Smaller arrays are validated sequentially
+    int chunkSize {1024};        // Elements per task
+    QThreadPool* threadPool {};  // Global instance if not set
+};
+
+class CompiledValidator
+{
+    NO_COPY_MOVE(CompiledValidator);
+public:
+    explicit CompiledValidator(const Internal::RootValidatorCPtr& root);
+    ~CompiledValidator();
+
+    bool check(ErrorInfo& logger, const QJsonValue& value, const ParallelOptions& parallel = {}) const;
+    bool check(ContextData& ctx, ErrorInfo& logger, const QJsonValue& value, const ParallelOptions& parallel = {}) const;
+
+    bool checkUtf8(ErrorInfo& logger, const QByteArray& utf8) const;
+    bool checkUtf8(ContextData& ctx, ErrorInfo& logger, const QByteArray& utf8) const;
+    bool checkDevice(ErrorInfo& logger, QIODevice& device) const; // Reads from current position
+    bool checkDevice(ContextData& ctx, ErrorInfo& logger, QIODevice& device) const;
+    bool checkFile(ErrorInfo& logger, const QString& fileName, FileAccess access = FileAccess::MemoryMapped) const;
+    bool checkFile(ContextData& ctx, ErrorInfo& logger, const QString& fileName, FileAccess access = FileAccess::MemoryMapped) const;
+
+    size_t instructionsCount() const;
+
+private:
+    DECLARE_PIMPL
+};
+
+using CompiledValidatorCPtr = std::shared_ptr<const CompiledValidator>;
+
 constexpr auto Exclusive = Internal::ExclusiveTag::Exclusive;
 constexpr auto Optional = Internal::OptionalTag::Optional;
 constexpr auto NonEmpty = Internal::NonEmptyTag::NonEmpty;
@@ -577,6 +713,8 @@ inline ValidatorCPtr CustomValidator(std::function<bool(const QJsonValue&)> chec
     return std::make_shared<Internal::CustomValidator>(check);
 }
 
+CompiledValidatorCPtr Compile(const RootValidatorCPtr& root);
+
 ValidatorCPtr CtxWriteArrayLength(const QString& ctxField);
 ValidatorCPtr CtxCheckArrayLength(const QString& ctxField);
 ValidatorCPtr CtxAppendToList(const QString& ctxField);
@@ -3,11 +3,34 @@
  * Contact:  ihor-drachuk-libs@pm.me  */
 
 #pragma once
+#include <algorithm>
 #include <cassert>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 #include <QObject>
+#include <QMetaMethod>
+#include <QThread>
 #include <QTimer>
 #include <UtilsQt/invoke_method.h>
 #include <UtilsQt/Futures/Utils.h>
+#include <utils-cpp/default_ctor_ops.h>
+#include <utils-cpp/pimpl.h>
+
+/*  Overview
+ *
+ *  onProperty / onPropertyFuture - wait until property reaches (or leaves) expected value.
+ *  Each call creates own watcher object, connections and timeout timer.
+ *
+ *  onPropertyShared / onPropertyFutureShared - one-shot variant for many simultaneous waits on the
+ *  same properties. There is single multiplexer per (object, getter, notifier): it holds one
+ *  connection to the notifier, calls the getter once per notification and checks all pending
+ *  expectations against that value. Contexts are tracked with one connection per context and
+ *  timeouts go through shared per-thread timer wheel (10 ms resolution) instead of QTimer per wait.
+ *  Handlers are called directly, so object, context and caller should live in the same thread.
+ */
 
 namespace UtilsQt {
 
@@ -104,6 +127,195 @@ private:
 inline void cancelStubHandler(UtilsQt::CancelReason) {}
 
 
+// Shared per-thread timer wheel with 10 ms resolution. Callbacks are never called earlier than requested.
+class TimerWheel : public QObject
+{
+    NO_COPY_MOVE(TimerWheel);
+public:
+    using Callback = std::function<void()>;
+
+    static TimerWheel& instance(); // For current thread
+
+    TimerWheel();
+    ~TimerWheel() override;
+
+    quint64 schedule(int timeoutMs, const Callback& callback);
+    void cancel(quint64 id);
+
+private:
+    void tick();
+
+private:
+    DECLARE_PIMPL
+};
+
+
+class MultiplexerBase : public QObject
+{
+public:
+    MultiplexerBase(QObject* object, int signalIndex);
+    ~MultiplexerBase() override;
+
+    int signalIndex() const { return m_signalIndex; }
+
+    static std::vector<MultiplexerBase*> multiplexersOf(QObject* object);
+
+private:
+    QObject* m_object;
+    int m_signalIndex;
+};
+
+
+template<typename T, typename Object, typename... SArgs>
+class PropertyMultiplexer : public MultiplexerBase
+{
+public:
+    using Getter = T (Object::*)() const;
+    using Notifier = void (Object::*)(SArgs...);
+    using Handler = std::function<void()>;
+    using CancelHandler = std::function<void(UtilsQt::CancelReason)>;
+
+    static PropertyMultiplexer* get(Object* object, Getter getter, Notifier notifier)
+    {
+        const auto signalIndex = QMetaMethod::fromSignal(notifier).methodIndex();
+
+        for (auto base : multiplexersOf(object)) {
+            if (base->signalIndex() != signalIndex)
+                continue;
+
+            auto mux = dynamic_cast<PropertyMultiplexer*>(base);
+            if (mux && mux->m_getter == getter)
+                return mux;
+        }
+
+        return new PropertyMultiplexer(object, getter, notifier, signalIndex);
+    }
+
+    ~PropertyMultiplexer() override {
+        // Object is being destroyed, don't call the getter anymore
+        finish([](const Expectation&){ return true; }, UtilsQt::CancelReason::Object);
+    }
+
+    void expect(const T& expectedValue, UtilsQt::Comparison comparison, QObject* context, int timeout,
+                const Handler& handler, const CancelHandler& cancelHandler)
+    {
+        if (matches((m_object->*m_getter)(), expectedValue, comparison)) {
+            handler();
+            return;
+        }
+
+        Expectation expectation {m_nextId++, expectedValue, comparison, context, handler, cancelHandler, 0};
+
+        if (timeout > 0) {
+            expectation.timerId = TimerWheel::instance().schedule(timeout, [this, id = expectation.id]() {
+                finish([id](const Expectation& x){ return x.id == id; }, UtilsQt::CancelReason::Timeout);
+            });
+        }
+
+        retainContext(context);
+        m_expectations.push_back(std::move(expectation));
+    }
+
+    size_t pendingCount() const { return m_expectations.size(); }
+
+private:
+    struct Expectation
+    {
+        quint64 id;
+        T expectedValue;
+        UtilsQt::Comparison comparison;
+        QObject* context;
+        Handler handler;
+        CancelHandler cancelHandler;
+        quint64 timerId;
+    };
+
+    struct ContextData
+    {
+        QMetaObject::Connection connection;
+        size_t count {0};
+    };
+
+    PropertyMultiplexer(Object* object, Getter getter, Notifier notifier, int signalIndex)
+        : MultiplexerBase(object, signalIndex),
+          m_object(object),
+          m_getter(getter)
+    {
+        QObject::connect(object, notifier, this, [this](){ onChanged(); });
+    }
+
+    static bool matches(const T& value, const T& expectedValue, UtilsQt::Comparison comparison) {
+        return (value == expectedValue) ^ (comparison == UtilsQt::Comparison::NotEqual);
+    }
+
+    void onChanged() {
+        if (m_expectations.empty())
+            return;
+
+        const T value = (m_object->*m_getter)();
+        finish([&value](const Expectation& x){ return matches(value, x.expectedValue, x.comparison); }, std::nullopt);
+    }
+
+    void retainContext(QObject* context) {
+        if (!context)
+            return;
+
+        auto& data = m_contexts[context];
+
+        if (!data.count++) {
+            data.connection = QObject::connect(context, &QObject::destroyed, this, [this, context](){
+                m_contexts.erase(context);
+                finish([context](const Expectation& x){ return x.context == context; }, UtilsQt::CancelReason::Context);
+            });
+        }
+    }
+
+    void releaseContext(QObject* context) {
+        const auto it = m_contexts.find(context);
+        if (it == m_contexts.end())
+            return;
+
+        if (!--it->second.count) {
+            QObject::disconnect(it->second.connection);
+            m_contexts.erase(it);
+        }
+    }
+
+    // Removes matching expectations first and then calls their handlers, so handlers can add new ones
+    template<typename Predicate>
+    void finish(const Predicate& predicate, std::optional<UtilsQt::CancelReason> cancelReason) {
+        const auto it = std::stable_partition(m_expectations.begin(), m_expectations.end(), [&predicate](const Expectation& x){ return !predicate(x); });
+        if (it == m_expectations.end())
+            return;
+
+        std::vector<Expectation> done(std::make_move_iterator(it), std::make_move_iterator(m_expectations.end()));
+        m_expectations.erase(it, m_expectations.end());
+
+        for (const auto& x : done) {
+            releaseContext(x.context);
+
+            if (x.timerId)
+                TimerWheel::instance().cancel(x.timerId);
+        }
+
+        for (const auto& x : done) {
+            if (cancelReason) {
+                x.cancelHandler(*cancelReason);
+            } else {
+                x.handler();
+            }
+        }
+    }
+
+private:
+    Object* m_object;
+    Getter m_getter;
+    quint64 m_nextId {1};
+    std::vector<Expectation> m_expectations;
+    std::unordered_map<QObject*, ContextData> m_contexts;
+};
+
+
 template<typename T, typename Getter, typename CancelHandler>
 PropertyWatcher<T, Getter, CancelHandler>* createWatcher(const Getter& getter, const T& expectedValue, UtilsQt::Comparison comparison, const CancelHandler& cancelHandler)
 {
@@ -181,4 +393,49 @@ QFuture<void> onPropertyFuture(Object* object,
     return promise.future();
 }
 
+template<typename T, typename... SArgs, typename Object, typename Handler, typename Handler2 = void (*)(UtilsQt::CancelReason),
+         typename std::enable_if<std::is_base_of<QObject, Object>::value>::type* = nullptr>
+void onPropertyShared(Object* object,
+                      T (Object::* getter)() const,
+                      void (Object::* notifier)(SArgs...),
+                      const T& expectedValue,
+                      UtilsQt::Comparison comparison,
+                      QObject* context,
+                      const Handler& handler,
+                      int timeout = -1,
+                      const Handler2& cancelHandler = UtilsQt::OnPropertyInternal::cancelStubHandler)
+{
+    assert(object);
+    assert(getter);
+    assert(notifier);
+    assert(object->thread() == QThread::currentThread() && "onPropertyShared should be called from object's thread!");
+
+    using Multiplexer = UtilsQt::OnPropertyInternal::PropertyMultiplexer<T, Object, SArgs...>;
+    Multiplexer::get(object, getter, notifier)->expect(expectedValue, comparison, context, timeout, handler, cancelHandler);
+}
+
+template<typename T, typename... SArgs, typename Object,
+         typename std::enable_if<std::is_base_of<QObject, Object>::value>::type* = nullptr>
+QFuture<void> onPropertyFutureShared(Object* object,
+                                     T (Object::* getter)() const,
+                                     void (Object::* notifier)(SArgs...),
+                                     const T& expectedValue,
+                                     UtilsQt::Comparison comparison,
+                                     QObject* context,
+                                     int timeout = -1)
+{
+    auto promise = UtilsQt::createPromise<void>(true);
+
+    onPropertyShared(object, getter, notifier, expectedValue, comparison, context,
+                     [promise]() mutable {
+                         promise.finish();
+                     },
+                     timeout,
+                     [promise](UtilsQt::CancelReason) mutable {
+                         promise.cancel();
+                     });
+
+    return promise.future();
+}
+
 } // namespace UtilsQt
@@ -5,6 +5,8 @@
 #pragma once
 #include <QObject>
 #include <QPolygonF>
+#include <QRectF>
+#include <QTransform>
 #include <QVector>
 #include <utils-cpp/default_ctor_ops.h>
 #include <utils-cpp/pimpl.h>
@@ -24,8 +26,21 @@ public:
     Q_INVOKABLE [[nodiscard]] QVector<QPolygonF> polygonsScale(const QVector<QPolygonF>& polygons, qreal xFactor, qreal yFactor) const;
     Q_INVOKABLE void polygonScaleRef(QPolygonF& polygon, qreal xFactor, qreal yFactor) const;
     Q_INVOKABLE void polygonsScaleRef(QVector<QPolygonF>& polygons, qreal xFactor, qreal yFactor) const;
+
+    // Batch operations over all points of all polygons (SIMD kernels, if available).
+    // *Ref versions work in place and return bounding rect of the result, calculated in the same pass.
+    Q_INVOKABLE [[nodiscard]] QVector<QPolygonF> polygonsTranslate(const QVector<QPolygonF>& polygons, qreal dx, qreal dy) const;
+    Q_INVOKABLE [[nodiscard]] QVector<QPolygonF> polygonsTransform(const QVector<QPolygonF>& polygons, const QTransform& transform) const;
+    Q_INVOKABLE QRectF polygonsTranslateRef(QVector<QPolygonF>& polygons, qreal dx, qreal dy) const;
+    Q_INVOKABLE QRectF polygonsTransformRef(QVector<QPolygonF>& polygons, const QTransform& transform) const;
+    Q_INVOKABLE [[nodiscard]] QRectF polygonsBoundingRect(const QVector<QPolygonF>& polygons) const;
+
     Q_INVOKABLE bool isPolygonRectangular(const QPolygonF& polygon) const;
 
+    // Indexes of points inside the polygon (same results as QPolygonF::containsPoint).
+    // For large polygons edges are indexed once, so each point checks only a few of them.
+    Q_INVOKABLE [[nodiscard]] QVector<int> pointsInPolygon(const QPolygonF& polygon, const QVector<QPointF>& points, Qt::FillRule fillRule = Qt::OddEvenFill) const;
+
 // --- Properties support ---
 public:
 
@@ -26,6 +26,7 @@ public:
 
     Q_INVOKABLE bool intersectsWithPoint(const QPointF& value) const;
     Q_INVOKABLE bool intersectsWithRect(const QRectF& value) const;
+    Q_INVOKABLE QVector<int> intersectingPoints(const QVector<QPointF>& values) const; // Indexes of points inside polygons
 
 // --- Properties support ---
 public:
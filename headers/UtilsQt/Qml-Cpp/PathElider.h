@@ -14,6 +14,7 @@
 #include <utils-cpp/pimpl.h>
 
 class QRegularExpression;
+class QThreadPool;
 
 struct PathEliderDecomposition
 {
@@ -55,6 +56,10 @@ public:
 
     Q_INVOKABLE PathEliderDecomposition decomposePath(const QString& path) const;
 
+    // Same result as `elidedText` of a PathElider per path, for list models.
+    // If `threadPool` is set, large lists are split into chunks elided in parallel.
+    static QStringList elideAll(const QStringList& paths, const QFont& font, int widthLimit, QThreadPool* threadPool = nullptr);
+
 // --- Properties support ---
 public:
     const QString& sourceText() const;
@@ -76,6 +81,7 @@ signals:
 // --- ---
 
 private:
+    static PathEliderDecomposition decompose(const QString& path);
     static QStringList separateSubdirs(const QString& path);
     void recalculate();
 
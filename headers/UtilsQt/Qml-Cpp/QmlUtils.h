@@ -3,7 +3,10 @@
  * Contact:  ihor-drachuk-libs@pm.me  */
 
 #pragma once
+#include <QByteArray>
 #include <QColor>
+#include <QFuture>
+#include <QImageIOHandler>
 #include <QList>
 #include <QObject>
 #include <QPoint>
@@ -33,6 +36,23 @@ struct PathDetails
     bool isAbsolute {};
 };
 
+struct ListFilesOptions
+{
+    bool recursive {false};
+    bool sorted {true};    // Case-insensitive sort like listFiles, otherwise discovery order
+    bool parallel {false}; // Walk top-level subdirectories concurrently (recursive only)
+};
+
+struct ImageMetadata
+{
+    QByteArray format; // Empty if file isn't an image
+    QSize size;        // As stored, before applying `transformation`
+    QImageIOHandler::Transformations transformation {}; // Orientation (EXIF, etc.)
+
+    bool isValid() const { return !format.isEmpty(); }
+    QSize orientedSize() const { return transformation.testFlag(QImageIOHandler::TransformationRotate90) ? size.transposed() : size; }
+};
+
 struct QUTimePoint
 {
     Q_GADGET
@@ -97,10 +117,16 @@ public:
     Q_INVOKABLE bool urlFileExists(const QUrl& url) const;
     Q_INVOKABLE bool localFileExists(const QString& fileName) const;
     Q_INVOKABLE QStringList listFiles(const QString& path, const QStringList& nameFilters = {}, bool recursive = false) const;
+    QFuture<QStringList> listFilesAsync(const QString& path, const QStringList& nameFilters = {}, const ListFilesOptions& options = {}) const; // Runs in QThreadPool, cancellable
 
     // Images
+    // Metadata is read from image headers only and cached (keyed by path, modification time and file size).
+    // Prefetch fills the cache in QThreadPool and returns count of found images; it's cancellable.
     Q_INVOKABLE bool isImage(const QString& fileName) const;
     Q_INVOKABLE QSize imageSize(const QString& fileName) const;
+    ImageMetadata imageMetadata(const QString& fileName) const;
+    QFuture<int> prefetchImageMetadata(const QStringList& fileNames) const;
+    QFuture<int> prefetchImageMetadata(const QString& path, const QStringList& nameFilters, bool recursive = false) const; // Directory
 
     // Size
     Q_INVOKABLE QSize fitSize(const QSize& sourceSize, const QSize& limits) const; // keep aspect ratio
@@ -122,8 +148,11 @@ public:
     Q_INVOKABLE bool compare(const QVariant& value1, const QVariant& value2) const;
 
     // Regex
-    Q_INVOKABLE QString extractByRegex(const QString& source, const QString& pattern) const;
-    Q_INVOKABLE QStringList extractByRegexGroups(const QString& source, const QString& pattern, const QList<int>& groups) const;
+    // Compiled patterns are kept in LRU cache (keyed by pattern and QRegularExpression::PatternOptions).
+    // Batch variant returns match (or empty string) for each source, optionally splitting work among threads.
+    Q_INVOKABLE QString extractByRegex(const QString& source, const QString& pattern, int options = 0) const;
+    Q_INVOKABLE QStringList extractByRegexGroups(const QString& source, const QString& pattern, const QList<int>& groups, int options = 0) const;
+    Q_INVOKABLE QStringList extractByRegexBatch(const QStringList& sources, const QString& pattern, int options = 0, bool parallel = false) const;
 
     // Convert
     Q_INVOKABLE QString toHex(int value, bool upperCase = true, int width = 0) const;
@@ -24,11 +24,19 @@
 //  - 'orientation' is the orientation of the image. E.g.: "horizontal" or "vertical"
 //  - 'top', 'bottom', 'left', and 'right' are the border sizes in pixels (optional, default to 0)
 //  - 'fill' is the fill mode. E.g.: "stretch" or "tile" (optional, default to "stretch")
+//
+// Parsed parameters and decoded (and scaled) sources are cached, resulting images are kept
+// in LRU cache limited by total size in bytes and keyed by id and requested size.
+// So repeated requests during window resizing don't touch the disk and don't re-render.
 
 class ImageProviderBorderImage : public QQuickImageProvider
 {
 public:
+    static constexpr qint64 DefaultCacheLimit = 32 * 1024 * 1024;
+
     static void registerTypes(QQmlEngine& engine);
+    static void setCacheLimit(qint64 bytes);
+    static void clearCache();
 
     ImageProviderBorderImage(): QQuickImageProvider(ImageType::Image) { }
     ImageProviderBorderImage(const ImageProviderBorderImage&) = delete;
@@ -4,6 +4,7 @@
 
 #pragma once
 #include <QQuickImageProvider>
+#include <QThreadPool>
 
 // To use this image provider, you should set the following in QML:
 // Image {
@@ -12,11 +13,22 @@
 //     source: "image://UtilsQt-Scaled/:/path/to/qrc-image.png"
 //     sourceSize: Qt.size(width, height)
 // }
+//
+// "image://UtilsQt-ScaledAsync/..." does the same, but decodes in a thread pool
+// instead of blocking the image loader.
+//
+// Image is decoded directly at the requested size, if the format supports it.
+// Scaled results are kept in LRU cache limited by total size in bytes and keyed by
+// path, modification time and requested size. The cache is shared by both providers.
 
 class ImageProviderScaled : public QQuickImageProvider
 {
 public:
+    static constexpr qint64 DefaultCacheLimit = 64 * 1024 * 1024;
+
     static void registerTypes(QQmlEngine& engine);
+    static void setCacheLimit(qint64 bytes);
+    static void clearCache();
 
     ImageProviderScaled(): QQuickImageProvider(ImageType::Image) { }
     ImageProviderScaled(const ImageProviderScaled&) = delete;
@@ -26,3 +38,22 @@ public:
 public: // QQuickImageProvider interface
     QImage requestImage(const QString& id, QSize* size, const QSize& requestedSize) override;
 };
+
+class ImageProviderScaledAsync : public QQuickAsyncImageProvider
+{
+public:
+    static void registerTypes(QQmlEngine& engine);
+
+    ImageProviderScaledAsync() = default;
+    ImageProviderScaledAsync(const ImageProviderScaledAsync&) = delete;
+
+    ImageProviderScaledAsync& operator=(const ImageProviderScaledAsync&) = delete;
+
+    QThreadPool& threadPool() { return m_threadPool; }
+
+public: // QQuickAsyncImageProvider interface
+    QQuickImageResponse* requestImageResponse(const QString& id, const QSize& requestedSize) override;
+
+private:
+    QThreadPool m_threadPool;
+};
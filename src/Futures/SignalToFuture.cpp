@@ -4,15 +4,57 @@
 
 #include <UtilsQt/Futures/SignalToFuture.h>
 
+#include <QThread>
 #include <QTimer>
+#include <vector>
 
 namespace UtilsQt {
 
 namespace Internal {
 
-void deleteAfter(QObject* object, std::chrono::milliseconds timeout)
+namespace {
+
+constexpr size_t MaxPooledContexts = 64;
+
+std::vector<std::unique_ptr<SignalContext>>& contextsPool()
+{
+    thread_local std::vector<std::unique_ptr<SignalContext>> pool;
+    return pool;
+}
+
+} // namespace
+
+SignalContext* acquireSignalContext()
+{
+    auto& pool = contextsPool();
+
+    if (pool.empty())
+        return new SignalContext();
+
+    auto ctx = pool.back().release();
+    pool.pop_back();
+    return ctx;
+}
+
+void releaseSignalContext(SignalContext* ctx)
+{
+    for (auto& connection : ctx->connections)
+        QObject::disconnect(std::exchange(connection, {}));
+
+    ctx->generation++;
+
+    auto& pool = contextsPool();
+
+    if (pool.size() < MaxPooledContexts && ctx->thread() == QThread::currentThread()) {
+        pool.emplace_back(ctx);
+    } else {
+        ctx->deleteLater();
+    }
+}
+
+void callAfter(QObject* ctx, std::chrono::milliseconds timeout, const std::function<void()>& func)
 {
-    QTimer::singleShot(timeout.count(), object, &QObject::deleteLater);
+    QTimer::singleShot(timeout.count(), ctx, func);
 }
 
 } // namespace Internal
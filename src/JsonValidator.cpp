@@ -9,10 +9,18 @@
 #include <QMap>
 #include <QByteArray>
 #include <QDebug>
+#include <QFile>
+#include <QIODevice>
+#include <QThreadPool>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <utility>
 
 #include <UtilsQt/qvariant_traits.h>
 
+#include "RunChunked.h"
+
 namespace UtilsQt {
 namespace JsonValidator {
 
@@ -60,6 +68,8 @@ bool MinMaxValidatorDouble::check(const QJsonValue& v) const {
 
 namespace {
 
+using JsonArraySize = decltype(std::declval<QJsonArray>().size()); // int in Qt 5
+
 const QMap<QJsonValue::Type, QString> jsonTypeToString = {
     {QJsonValue::Type::Null, "Null"},
     {QJsonValue::Type::Bool, "Boolean"},
@@ -89,7 +99,90 @@ QString valueToString(const QJsonValue& value)
 
 } // namespace
 
-bool Object::check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+size_t JsonValueHash::operator()(const QJsonValue& value) const
+{
+    switch (value.type()) {
+        case QJsonValue::Type::Bool:
+            return qHash(value.toBool() ? 1 : 0);
+
+        case QJsonValue::Type::Double: {
+            const auto number = value.toDouble();
+            return qHash(number == 0.0 ? 0.0 : number); // -0.0 == 0.0
+        }
+
+        case QJsonValue::Type::String:
+            return qHash(value.toString());
+
+        case QJsonValue::Type::Null:
+        case QJsonValue::Type::Array:
+        case QJsonValue::Type::Object:
+        case QJsonValue::Type::Undefined:
+            break;
+    }
+
+    // Arrays and objects are rare in lists, they're just compared
+    return qHash(static_cast<int>(value.type()));
+}
+
+class ContextLists
+{
+public:
+    static void append(ContextData& ctx, const QString& field, const QJsonValue& value)
+    {
+        auto& variant = ctx[field];
+
+        if (variant.userType() != qMetaTypeId<QVariantList>())
+            variant = variant.isValid() ? variant.toList() : QVariantList();
+
+        // Modify in place, so appending isn't O(n)
+        auto& list = *static_cast<QVariantList*>(variant.data());
+        auto& index = actualIndex(ctx, field, list);
+
+        index.list = QVariantList(); // Don't make append detach (copy) the list
+        list.append(QVariant(value));
+        index.values.insert(value);
+        index.list = list;
+    }
+
+    static bool contains(ContextData& ctx, const QString& field, const QJsonValue& value)
+    {
+        const auto it = ctx.constFind(field);
+        if (it == ctx.constEnd())
+            return false;
+
+        if (it->userType() != qMetaTypeId<QVariantList>())
+            return it->toList().contains(QVariant(value));
+
+        const auto& list = *static_cast<const QVariantList*>(it->constData());
+        return actualIndex(ctx, field, list).values.count(value);
+    }
+
+    static void remove(ContextData& ctx, const QString& field)
+    {
+        ctx.remove(field);
+        ctx.m_listIndexes.remove(field);
+    }
+
+private:
+    // Rebuilds index if the list was replaced or changed not by CtxAppendToList
+    static ContextData::ListIndex& actualIndex(ContextData& ctx, const QString& field, const QVariantList& list)
+    {
+        auto& index = ctx.m_listIndexes[field];
+
+        if (!index.list.isSharedWith(list) || index.list.size() != list.size()) {
+            index.values.clear();
+
+            for (const auto& x : list)
+                index.values.insert(QJsonValue::fromVariant(x));
+
+            index.list = list;
+        }
+
+        return index;
+    }
+};
+
+bool Object::check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const
 {
     if (!value.isObject()) {
         logger.notifyError(path, "Object expected, but it's of type \"" + jsonTypeToString.value(value.type()) + "\"");
@@ -99,37 +192,43 @@ bool Object::check(ContextData& ctx, ErrorInfo& logger, const QString& path, con
     return checkNested(ctx, logger, path, value);
 }
 
-bool Array::check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+bool Array::check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const
 {
     if (!value.isArray()) {
         logger.notifyError(path, "Array expected, but it's of type \"" + jsonTypeToString.value(value.type()) + "\"");
         return false;
     }
 
-    auto array = value.toArray();
+    const auto array = value.toArray();
+    bool result = true;
+
+    path.pushIndex(0);
 
     for (int i = 0; i < array.size(); i++) {
-        const auto nestedValue = array.at(i);
-        const auto newPath = path + QString("[%1]").arg(i);
-        const auto iResult = checkNested(ctx, logger, newPath, nestedValue);
+        path.setIndex(i);
 
-        if (!iResult)
-            return false;
+        if (!checkNested(ctx, logger, path, array.at(i))) {
+            result = false;
+            break;
+        }
     }
 
-    return true;
+    path.pop();
+    return result;
 }
 
-bool Field::check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+bool Field::check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const
 {
     assert(value.isObject());
-    auto obj = value.toObject();
+    const auto obj = value.toObject();
+    const auto it = obj.constFind(m_key);
 
-    if (obj.contains(m_key)) {
-        const auto nestedValue = obj.value(m_key);
-        const auto newPath = path + "/" + m_key;
+    if (it != obj.constEnd()) {
+        path.pushKey(m_key);
+        const auto result = checkNested(ctx, logger, path, it.value());
+        path.pop();
 
-        return checkNested(ctx, logger, newPath, nestedValue);
+        return result;
     } else {
         if (m_optional) { // It's OK.
             return true;
@@ -140,7 +239,7 @@ bool Field::check(ContextData& ctx, ErrorInfo& logger, const QString& path, cons
     }
 }
 
-bool Or::check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+bool Or::check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const
 {
     ErrorInfo proxyLogger;
 
@@ -180,7 +279,7 @@ bool Or::check(ContextData& ctx, ErrorInfo& logger, const QString& path, const Q
     return false;
 }
 
-bool String::check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+bool String::check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const
 {
     auto ok = value.isString();
 
@@ -236,7 +335,7 @@ bool String::check(ContextData& ctx, ErrorInfo& logger, const QString& path, con
     return checkNested(ctx, logger, path, value);
 }
 
-bool Bool::check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+bool Bool::check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const
 {
     auto ok = value.isBool();
 
@@ -248,7 +347,7 @@ bool Bool::check(ContextData& ctx, ErrorInfo& logger, const QString& path, const
     return checkNested(ctx, logger, path, value);
 }
 
-bool Number::check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+bool Number::check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const
 {
     auto ok = value.isDouble();
 
@@ -286,30 +385,26 @@ bool Number::check(ContextData& ctx, ErrorInfo& logger, const QString& path, con
     return checkNested(ctx, logger, path, value);
 }
 
-bool Exclude::check(ContextData& /*ctx*/, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+bool Exclude::check(ContextData& /*ctx*/, ErrorInfo& logger, Path& path, const QJsonValue& value) const
 {
-    for (const auto& x : m_values) {
-        if (value == x) {
-            logger.notifyError(path, "Value shouldn't be equal to: " + valueToString(value));
-            return false;
-        }
+    if (m_values.count(value)) {
+        logger.notifyError(path, "Value shouldn't be equal to: " + valueToString(value));
+        return false;
     }
 
     return true;
 }
 
-bool Include::check(ContextData& /*ctx*/, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+bool Include::check(ContextData& /*ctx*/, ErrorInfo& logger, Path& path, const QJsonValue& value) const
 {
-    for (const auto& x : m_values) {
-        if (value == x)
-            return true;
-    }
+    if (m_values.count(value))
+        return true;
 
     logger.notifyError(path, "This value doesn't match to 'include' filter: " + valueToString(value));
     return false;
 }
 
-bool And::check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+bool And::check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const
 {
     return checkNested(ctx, logger, path, value);
 }
@@ -317,27 +412,36 @@ bool And::check(ContextData& ctx, ErrorInfo& logger, const QString& path, const
 bool RootValidator::check(ErrorInfo& logger, const QJsonValue& value) const
 {
     ContextData ctx;
-    return check(ctx, logger, "", value);
+    Path path;
+    return check(ctx, logger, path, value);
 }
 
-bool RootValidator::check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+bool RootValidator::check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const
 {
     return checkNested(ctx, logger, path, value);
 }
 
-bool CtxWriteArrayLength::check(ContextData& ctx, ErrorInfo& /*logger*/, const QString& /*path*/, const QJsonValue& value) const
+bool ArrayLengthValidator::check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const
 {
-    assert(value.isArray());
-    ctx[m_ctxField] = value.toArray().size();
+    if (!value.isArray()) {
+        logger.notifyError(path, "Array expected, but it's of type \"" + jsonTypeToString.value(value.type()) + "\"");
+        return false;
+    }
+
+    return checkLength(ctx, logger, path, value.toArray().size());
+}
+
+bool CtxWriteArrayLength::checkLength(ContextData& ctx, ErrorInfo& /*logger*/, Path& /*path*/, qsizetype length) const
+{
+    ctx[m_ctxField] = static_cast<JsonArraySize>(length);
     return true;
 }
 
-bool CtxCheckArrayLength::check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+bool CtxCheckArrayLength::checkLength(ContextData& ctx, ErrorInfo& logger, Path& path, qsizetype length) const
 {
-    assert(value.isArray());
     assert(ctx.contains(m_ctxField));
 
-    auto arrSize = value.toArray().size();
+    auto arrSize = static_cast<JsonArraySize>(length);
     auto expSize = ctx.value(m_ctxField).toInt();
     if (arrSize != expSize) {
         logger.notifyError(path, QString("Expected %1 items in array, but there %3 %2")
@@ -350,28 +454,18 @@ bool CtxCheckArrayLength::check(ContextData& ctx, ErrorInfo& logger, const QStri
     return true;
 }
 
-bool CtxAppendToList::check(ContextData& ctx, ErrorInfo& /*logger*/, const QString& /*path*/, const QJsonValue& value) const
+bool CtxAppendToList::check(ContextData& ctx, ErrorInfo& /*logger*/, Path& /*path*/, const QJsonValue& value) const
 {
     assert(!ctx.contains(m_ctxField) || QVariantTraits::isList(ctx.value(m_ctxField)));
-
-    if (ctx.contains(m_ctxField)) {
-        auto list = ctx.value(m_ctxField).toList();
-        list.append(value);
-        ctx[m_ctxField] = list;
-    } else {
-        ctx[m_ctxField] = QVariantList{value};
-    }
-
+    ContextLists::append(ctx, m_ctxField, value);
     return true;
 }
 
-bool CtxCheckInList::check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+bool CtxCheckInList::check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const
 {
     assert(ctx.contains(m_ctxField) && QVariantTraits::isList(ctx.value(m_ctxField)));
 
-    auto list = ctx.value(m_ctxField).toList();
-
-    if (!list.contains(value)) {
+    if (!ContextLists::contains(ctx, m_ctxField, value)) {
         logger.notifyError(path, QString("This value failed in-list check: %1").arg(valueToString(value)));
         return false;
     }
@@ -379,13 +473,11 @@ bool CtxCheckInList::check(ContextData& ctx, ErrorInfo& logger, const QString& p
     return true;
 }
 
-bool CtxCheckNotInList::check(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+bool CtxCheckNotInList::check(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const
 {
     assert(!ctx.contains(m_ctxField) || QVariantTraits::isList(ctx.value(m_ctxField)));
 
-    auto list = ctx.value(m_ctxField).toList();
-
-    if (list.contains(value)) {
+    if (ContextLists::contains(ctx, m_ctxField, value)) {
         logger.notifyError(path, QString("This value failed not-in-list check: %1").arg(valueToString(value)));
         return false;
     }
@@ -393,20 +485,15 @@ bool CtxCheckNotInList::check(ContextData& ctx, ErrorInfo& logger, const QString
     return true;
 }
 
-bool CtxClearRecord::check(ContextData& ctx, ErrorInfo& /*logger*/, const QString& /*path*/, const QJsonValue& /*value*/) const
+bool CtxClearRecord::check(ContextData& ctx, ErrorInfo& /*logger*/, Path& /*path*/, const QJsonValue& /*value*/) const
 {
-    ctx.remove(m_ctxField);
+    ContextLists::remove(ctx, m_ctxField);
     return true;
 }
 
-bool ArrayLength::check(ContextData& /*ctx*/, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+bool ArrayLength::checkLength(ContextData& /*ctx*/, ErrorInfo& logger, Path& path, qsizetype length) const
 {
-    if (!value.isArray()) {
-        logger.notifyError(path, "Array expected, but it's of type \"" + jsonTypeToString.value(value.type()) + "\"");
-        return false;
-    }
-
-    const size_t arraySize = static_cast<size_t>(value.toArray().size());
+    const size_t arraySize = static_cast<size_t>(length);
     if (m_min && arraySize < *m_min) {
         logger.notifyError(path, QString("Array length is too short: %1, but should be at least %2").arg(arraySize).arg(*m_min));
         return false;
@@ -425,7 +512,7 @@ bool ArrayLength::check(ContextData& /*ctx*/, ErrorInfo& logger, const QString&
     return true;
 }
 
-bool CustomValidator::check(ContextData& /*ctx*/, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+bool CustomValidator::check(ContextData& /*ctx*/, ErrorInfo& logger, Path& path, const QJsonValue& value) const
 {
     if (!m_validator(value)) {
         logger.notifyError(path, "Custom validation failed");
@@ -437,6 +524,22 @@ bool CustomValidator::check(ContextData& /*ctx*/, ErrorInfo& logger, const QStri
 
 } // namespace Internal
 
+QString Path::toString() const
+{
+    QString result;
+
+    for (const auto& x : m_segments) {
+        if (x.key) {
+            result += '/';
+            result += *x.key;
+        } else {
+            result += QString("[%1]").arg(x.index);
+        }
+    }
+
+    return result;
+}
+
 void ErrorInfo::notifyError(const QString& path, const QString& error)
 {
     m_hasError = true;
@@ -463,7 +566,7 @@ void LoggedErrorInfo::notifyErrorImpl(const QString& path, const QString& error)
     qCritical().noquote() << "Error: " << error;
 }
 
-bool Validator::checkNested(ContextData& ctx, ErrorInfo& logger, const QString& path, const QJsonValue& value) const
+bool Validator::checkNested(ContextData& ctx, ErrorInfo& logger, Path& path, const QJsonValue& value) const
 {
     for (const auto& x : m_validators) {
         auto ok = x->check(ctx, logger, path, value);
@@ -477,6 +580,1170 @@ bool Validator::checkNested(ContextData& ctx, ErrorInfo& logger, const QString&
     return true;
 }
 
+// --- Compiled validator ---
+
+namespace Internal {
+
+namespace {
+
+enum class OpCode : quint8
+{
+    Sequence, // RootValidator, And
+    Object,
+    Array,
+    Field,
+    Or,
+    TypeOnly, // String, Bool, Number without additional constraints
+    Leaf      // Anything else: calls Validator::check (handles its nested validators itself)
+};
+
+using TypeMask = quint8;
+constexpr TypeMask AnyType = 0xFF;
+
+TypeMask typeBit(QJsonValue::Type type)
+{
+    switch (type) {
+        case QJsonValue::Type::Null:      return 1 << 0;
+        case QJsonValue::Type::Bool:      return 1 << 1;
+        case QJsonValue::Type::Double:    return 1 << 2;
+        case QJsonValue::Type::String:    return 1 << 3;
+        case QJsonValue::Type::Array:     return 1 << 4;
+        case QJsonValue::Type::Object:    return 1 << 5;
+        case QJsonValue::Type::Undefined: return 1 << 6;
+    }
+
+    return 1 << 6;
+}
+
+} // namespace
+
+struct Instruction
+{
+    OpCode op {};
+    bool optional {};             // Field
+    bool exclusive {};            // Or
+    bool contextFree {true};      // No Ctx* (or unknown) validators in the subtree
+    bool fieldsOnly {};           // Object, which has only Field children
+    bool lengthOnly {};           // ArrayLengthValidator
+    bool ignoresValue {};         // CtxClearRecord
+    TypeMask typeMask {AnyType};  // Types, for which the node can pass its first check
+    int end {};                   // Index after the last instruction of the subtree
+    const Validator* validator {};
+    const QString* key {};        // Field
+};
+
+class Compiler
+{
+public:
+    static std::vector<Instruction> compile(const RootValidator& root)
+    {
+        std::vector<Instruction> program;
+        compileNode(program, root);
+        return program;
+    }
+
+private:
+    static void compileNode(std::vector<Instruction>& program, const Validator& validator)
+    {
+        const auto index = program.size();
+        program.push_back({});
+
+        Instruction ins;
+        ins.validator = &validator;
+        bool compileChildren = true;
+
+        if (dynamic_cast<const RootValidator*>(&validator) || dynamic_cast<const And*>(&validator)) {
+            ins.op = OpCode::Sequence;
+        } else if (dynamic_cast<const Object*>(&validator)) {
+            ins.op = OpCode::Object;
+            ins.typeMask = typeBit(QJsonValue::Type::Object);
+        } else if (dynamic_cast<const Array*>(&validator)) {
+            ins.op = OpCode::Array;
+            ins.typeMask = typeBit(QJsonValue::Type::Array);
+        } else if (auto field = dynamic_cast<const Field*>(&validator)) {
+            ins.op = OpCode::Field;
+            ins.key = &field->m_key;
+            ins.optional = field->m_optional;
+        } else if (auto orValidator = dynamic_cast<const Or*>(&validator)) {
+            ins.op = OpCode::Or;
+            ins.exclusive = orValidator->m_exclusive;
+        } else if (auto str = dynamic_cast<const String*>(&validator)) {
+            const bool constrained = str->m_nonEmpty || str->m_hex || str->m_base64 || str->m_ipv4;
+            ins.op = constrained ? OpCode::Leaf : OpCode::TypeOnly;
+            ins.typeMask = typeBit(QJsonValue::Type::String);
+        } else if (dynamic_cast<const Bool*>(&validator)) {
+            ins.op = OpCode::TypeOnly;
+            ins.typeMask = typeBit(QJsonValue::Type::Bool);
+        } else if (auto number = dynamic_cast<const Number*>(&validator)) {
+            const bool constrained = number->m_isIntegerExpected ||
+                                     dynamic_cast<const MinMaxValidatorInt*>(number->m_validator.get()) ||
+                                     dynamic_cast<const MinMaxValidatorDouble*>(number->m_validator.get());
+            ins.op = constrained ? OpCode::Leaf : OpCode::TypeOnly;
+            ins.typeMask = typeBit(QJsonValue::Type::Double);
+        } else {
+            ins.op = OpCode::Leaf;
+            if (dynamic_cast<const ArrayLength*>(&validator))
+                ins.typeMask = typeBit(QJsonValue::Type::Array);
+
+            ins.lengthOnly = dynamic_cast<const ArrayLengthValidator*>(&validator);
+            ins.ignoresValue = dynamic_cast<const CtxClearRecord*>(&validator);
+        }
+
+        if (ins.op == OpCode::Leaf) {
+            compileChildren = false;
+            ins.contextFree = isContextFreeLeaf(validator);
+        }
+
+        if (compileChildren) {
+            for (const auto& x : validator.m_validators)
+                compileNode(program, *x);
+        }
+
+        ins.end = static_cast<int>(program.size());
+
+        for (int j = static_cast<int>(index) + 1; j < ins.end && ins.contextFree; j = program[j].end)
+            ins.contextFree = program[j].contextFree;
+
+        if (ins.op == OpCode::Object) {
+            ins.fieldsOnly = true;
+            for (int j = static_cast<int>(index) + 1; j < ins.end && ins.fieldsOnly; j = program[j].end)
+                ins.fieldsOnly = (program[j].op == OpCode::Field);
+        }
+
+        // Type mask of the first check, which fails without side effects
+        if (ins.op == OpCode::Sequence && ins.end > static_cast<int>(index) + 1) {
+            ins.typeMask = program[index + 1].typeMask;
+        } else if (ins.op == OpCode::Or) {
+            ins.typeMask = 0;
+            for (int j = static_cast<int>(index) + 1; j < ins.end; j = program[j].end)
+                ins.typeMask |= program[j].typeMask;
+        }
+
+        program[index] = ins;
+    }
+
+    // Known validators, which don't touch ContextData (including their nested ones)
+    static bool isContextFreeLeaf(const Validator& validator)
+    {
+        const bool known = dynamic_cast<const String*>(&validator) ||
+                           dynamic_cast<const Number*>(&validator) ||
+                           dynamic_cast<const Bool*>(&validator) ||
+                           dynamic_cast<const Include*>(&validator) ||
+                           dynamic_cast<const Exclude*>(&validator) ||
+                           dynamic_cast<const ArrayLength*>(&validator) ||
+                           dynamic_cast<const CustomValidator*>(&validator);
+
+        if (!known)
+            return false;
+
+        for (const auto& x : validator.m_validators)
+            if (!isContextFreeLeaf(*x))
+                return false;
+
+        return true;
+    }
+};
+
+class Interpreter
+{
+public:
+    Interpreter(const std::vector<Instruction>& program, ContextData& ctx, ErrorInfo& logger, const ParallelOptions* parallel = nullptr)
+        : m_program(program),
+          m_ctx(ctx),
+          m_logger(logger),
+          m_parallel(parallel && parallel->enabled ? parallel : nullptr)
+    { }
+
+    bool run(int index, const QJsonValue& value) { return run(index, m_logger, value); }
+
+private:
+    friend class StreamInterpreter;
+
+    bool runChildren(int index, ErrorInfo& logger, const QJsonValue& value)
+    {
+        const auto end = m_program[index].end;
+
+        for (int j = index + 1; j < end; j = m_program[j].end)
+            if (!run(j, logger, value))
+                return false;
+
+        return true;
+    }
+
+    bool run(int index, ErrorInfo& logger, const QJsonValue& value)
+    {
+        const auto& ins = m_program[index];
+
+        // Wrong type: let the validator report exactly the same error
+        if (!(ins.typeMask & typeBit(value.type())))
+            return ins.validator->check(m_ctx, logger, m_path, value);
+
+        switch (ins.op) {
+            case OpCode::Sequence:
+            case OpCode::Object:
+            case OpCode::TypeOnly:
+                return runChildren(index, logger, value);
+
+            case OpCode::Array: {
+                const auto array = value.toArray();
+
+                if (m_parallel && ins.contextFree && array.size() >= std::max(2, m_parallel->minArraySize))
+                    return runArrayParallel(index, logger, array);
+
+                bool result = true;
+
+                m_path.pushIndex(0);
+
+                for (int i = 0; i < array.size(); i++) {
+                    m_path.setIndex(i);
+
+                    if (!runChildren(index, logger, array.at(i))) {
+                        result = false;
+                        break;
+                    }
+                }
+
+                m_path.pop();
+                return result;
+            }
+
+            case OpCode::Field: {
+                assert(value.isObject());
+                const auto obj = value.toObject();
+                const auto it = obj.constFind(*ins.key);
+
+                if (it == obj.constEnd())
+                    return ins.optional || ins.validator->check(m_ctx, logger, m_path, value);
+
+                m_path.pushKey(*ins.key);
+                const auto result = runChildren(index, logger, it.value());
+                m_path.pop();
+                return result;
+            }
+
+            case OpCode::Or:
+                return runOr(index, logger, value);
+
+            case OpCode::Leaf:
+                return ins.validator->check(m_ctx, logger, m_path, value);
+        }
+
+        assert(false && "Unexpected opcode!");
+        return false;
+    }
+
+    // Elements are independent here. Each chunk stops on its first error or when an earlier error is
+    // already found; the error with the lowest index is reported.
+    bool runArrayParallel(int index, ErrorInfo& logger, const QJsonArray& array)
+    {
+        const int count = array.size();
+        const int chunkSize = std::max(1, m_parallel->chunkSize);
+        const int chunks = (count + chunkSize - 1) / chunkSize;
+
+        std::vector<ErrorInfo> errors(chunks);
+        std::atomic<int> firstError {count};
+
+        auto processChunk = [this, index, &array, &errors, &firstError, count, chunkSize](int chunk) {
+            const int begin = chunk * chunkSize;
+            const int end = std::min(count, begin + chunkSize);
+
+            ContextData ctx; // Not used by context-free validators
+            Interpreter worker(m_program, ctx, errors[chunk]); // Nested arrays are sequential
+            worker.m_path = m_path;
+            worker.m_path.pushIndex(begin);
+
+            for (int i = begin; i < end; i++) {
+                if (i > firstError.load(std::memory_order_relaxed))
+                    return;
+
+                worker.m_path.setIndex(i);
+
+                if (!worker.runChildren(index, errors[chunk], array.at(i))) {
+                    auto current = firstError.load(std::memory_order_relaxed);
+                    while (i < current && !firstError.compare_exchange_weak(current, i, std::memory_order_relaxed)) { }
+                    return;
+                }
+            }
+        };
+
+        runChunked(m_parallel->threadPool ? m_parallel->threadPool : QThreadPool::globalInstance(), chunks, processChunk);
+
+        const auto errorIndex = firstError.load();
+        if (errorIndex == count)
+            return true;
+
+        const auto& error = errors[errorIndex / chunkSize];
+        assert(error.hasError());
+        logger.notifyError(error.getErrorPath(), error.getErrorDescription());
+        return false;
+    }
+
+    // Same logic as Or::check, but branches which can't accept the value's type aren't run.
+    // They'd fail on the first check without side effects anyway.
+    bool runOr(int index, ErrorInfo& logger, const QJsonValue& value)
+    {
+        const auto& ins = m_program[index];
+        const auto valueType = typeBit(value.type());
+
+        ErrorInfo proxyLogger;
+        size_t matchingItemsCnt = 0;
+        int lastBranch = -1;
+        bool lastBranchRun = false;
+
+        for (int j = index + 1; j < ins.end; j = m_program[j].end) {
+            lastBranch = j;
+            lastBranchRun = (m_program[j].typeMask & valueType);
+
+            if (!lastBranchRun)
+                continue;
+
+            proxyLogger.clear();
+
+            if (run(j, proxyLogger, value)) {
+                if (!ins.exclusive) return true;
+                matchingItemsCnt++;
+            }
+        }
+
+        // Or::check reports state of the last branch's logger
+        if (lastBranch >= 0 && !lastBranchRun) {
+            proxyLogger.clear();
+            run(lastBranch, proxyLogger, value);
+        }
+
+        if (ins.exclusive) {
+            if (matchingItemsCnt == 1) {
+                return true;
+
+            } else if (matchingItemsCnt > 1) {
+                logger.notifyError(proxyLogger.getErrorPath(), "Exclusive OR-condition expected, but several items are matching!");
+                return false;
+            }
+        }
+
+        assert(proxyLogger.hasError());
+        logger.notifyError(proxyLogger.getErrorPath(), proxyLogger.getErrorDescription());
+        return false;
+    }
+
+private:
+    const std::vector<Instruction>& m_program;
+    ContextData& m_ctx;
+    ErrorInfo& m_logger;
+    const ParallelOptions* m_parallel {};
+    Path m_path;
+};
+
+// Bytes of a document: contiguous memory (QByteArray, mapped file) or a device read in chunks
+class ByteSource
+{
+public:
+    ByteSource(const char* data, qint64 size)
+        : m_begin(data),
+          m_pos(data),
+          m_end(data + size)
+    { }
+
+    explicit ByteSource(QIODevice& device)
+        : m_device(&device)
+    { }
+
+    int peek()
+    {
+        if (m_pos == m_end && !refill())
+            return -1;
+
+        return static_cast<unsigned char>(*m_pos);
+    }
+
+    int get()
+    {
+        const auto c = peek();
+        if (c >= 0)
+            m_pos++;
+        return c;
+    }
+
+    qint64 offset() const { return m_consumed + (m_pos - m_begin); }
+
+private:
+    bool refill()
+    {
+        if (!m_device)
+            return false;
+
+        m_consumed += m_end - m_begin;
+        m_buffer.resize(ChunkSize);
+
+        auto count = m_device->read(m_buffer.data(), ChunkSize);
+
+        // Sockets, processes: wait for more data
+        while (count == 0 && m_device->isSequential() && m_device->waitForReadyRead(-1))
+            count = m_device->read(m_buffer.data(), ChunkSize);
+
+        if (count <= 0) {
+            m_begin = m_pos = m_end = nullptr;
+            return false;
+        }
+
+        m_begin = m_pos = m_buffer.constData();
+        m_end = m_begin + count;
+        return true;
+    }
+
+private:
+    static constexpr qint64 ChunkSize = 64 * 1024;
+
+    QIODevice* m_device {};
+    QByteArray m_buffer;
+    const char* m_begin {};
+    const char* m_pos {};
+    const char* m_end {};
+    qint64 m_consumed {};
+};
+
+// Parses JSON from ByteSource and drives the compiled program over it. Arrays and objects are
+// streamed when validators don't need them as a whole, otherwise they're built and passed to
+// Interpreter. Scalars are always passed to Interpreter, so checks and errors are exactly the same.
+// Stops on the first error.
+class StreamInterpreter
+{
+public:
+    StreamInterpreter(const std::vector<Instruction>& program, ContextData& ctx, ErrorInfo& logger, ByteSource& source)
+        : m_program(program),
+          m_interpreter(program, ctx, logger),
+          m_logger(logger),
+          m_source(source)
+    { }
+
+    bool run()
+    {
+        if (!value(0, m_program[0].end))
+            return false;
+
+        if (peekToken() >= 0)
+            return syntaxError("unexpected data after the document");
+
+        return true;
+    }
+
+private:
+    static constexpr int MaxDepth = 1024;
+
+    // Validates current value with the sibling instructions [first, end), like Interpreter::runChildren
+    bool value(int first, int end)
+    {
+        const auto c = peekToken();
+        const auto type = c == '{' ? QJsonValue::Type::Object :
+                          c == '[' ? QJsonValue::Type::Array : QJsonValue::Type::Undefined;
+
+        if (type != QJsonValue::Type::Undefined && canStreamRange(first, end, type)) {
+            qsizetype length = 0;
+            return streamRange(first, end, type, length);
+        }
+
+        QJsonValue v;
+        if (!build(v))
+            return false;
+
+        for (int j = first; j < end; j = m_program[j].end)
+            if (!m_interpreter.run(j, m_logger, v))
+                return false;
+
+        return true;
+    }
+
+    // At most one instruction consumes the value while it's read. The others should either ignore
+    // the value, or need only array length and go after the consumer (they're run when it's read).
+    bool canStreamRange(int first, int end, QJsonValue::Type type) const
+    {
+        bool consumer = false;
+        bool lengthOnly = false;
+
+        for (int j = first; j < end; j = m_program[j].end) {
+            const auto& ins = m_program[j];
+
+            if (ins.ignoresValue)
+                continue;
+
+            if (ins.lengthOnly && type == QJsonValue::Type::Array) {
+                lengthOnly = true;
+                continue;
+            }
+
+            if (consumer || lengthOnly || !canStream(j, type))
+                return false;
+
+            consumer = true;
+        }
+
+        return true;
+    }
+
+    bool canStream(int index, QJsonValue::Type type) const
+    {
+        const auto& ins = m_program[index];
+
+        if (!(ins.typeMask & typeBit(type)))
+            return false;
+
+        switch (ins.op) {
+            case OpCode::Sequence: return canStreamRange(index + 1, ins.end, type);
+            case OpCode::Object:   return type == QJsonValue::Type::Object && ins.fieldsOnly;
+            case OpCode::Array:    return type == QJsonValue::Type::Array;
+            default:               return false;
+        }
+    }
+
+    // `length` is set for arrays
+    bool streamRange(int first, int end, QJsonValue::Type type, qsizetype& length)
+    {
+        int consumer = end;
+
+        for (int j = first; j < end; j = m_program[j].end) {
+            if (!m_program[j].ignoresValue && !m_program[j].lengthOnly) {
+                consumer = j;
+                break;
+            }
+        }
+
+        const bool hasConsumer = (consumer < end);
+
+        if (hasConsumer) {
+            // Only value-independent checks are before the consumer
+            for (int j = first; j < consumer; j = m_program[j].end)
+                if (!m_interpreter.run(j, m_logger, QJsonValue()))
+                    return false;
+
+            if (!stream(consumer, type, length))
+                return false;
+        } else {
+            if (!skip(&length))
+                return false;
+        }
+
+        for (int j = (hasConsumer ? m_program[consumer].end : first); j < end; j = m_program[j].end) {
+            const auto& ins = m_program[j];
+            const auto ok = ins.lengthOnly ?
+                                static_cast<const ArrayLengthValidator*>(ins.validator)->checkLength(m_interpreter.m_ctx, m_logger, m_interpreter.m_path, length) :
+                                m_interpreter.run(j, m_logger, QJsonValue());
+            if (!ok)
+                return false;
+        }
+
+        return true;
+    }
+
+    bool stream(int index, QJsonValue::Type type, qsizetype& length)
+    {
+        const auto& ins = m_program[index];
+
+        switch (ins.op) {
+            case OpCode::Sequence: return streamRange(index + 1, ins.end, type, length);
+            case OpCode::Object:   return streamObject(index);
+            case OpCode::Array:    return streamArray(index, length);
+            default:               break;
+        }
+
+        assert(false && "Unexpected opcode!");
+        return false;
+    }
+
+    bool streamArray(int index, qsizetype& length)
+    {
+        const auto end = m_program[index].end;
+        auto& path = m_interpreter.m_path;
+
+        if (!enter())
+            return false;
+
+        path.pushIndex(0);
+        length = 0;
+
+        if (peekToken() == ']') {
+            m_source.get();
+        } else {
+            for (;;) {
+                path.setIndex(static_cast<int>(length));
+
+                if (!value(index + 1, end))
+                    return false;
+
+                length++;
+
+                const auto c = getToken();
+                if (c == ']') break;
+                if (c != ',') return syntaxError("',' or ']' expected");
+            }
+        }
+
+        path.pop();
+        m_depth--;
+        return true;
+    }
+
+    // Fields are checked in validator's order, as Interpreter does. A field, which comes before the
+    // preceding ones, is built and waits for them. For duplicate keys the first value is used, later
+    // ones are skipped (unlike QJsonDocument, which keeps the last one).
+    bool streamObject(int index)
+    {
+        const auto end = m_program[index].end;
+        auto& path = m_interpreter.m_path;
+        int next = index + 1;
+        std::vector<std::pair<int, QJsonValue>> pending;
+        QString key;
+
+        if (!enter())
+            return false;
+
+        if (peekToken() == '}') {
+            m_source.get();
+        } else {
+            for (;;) {
+                if (getToken() != '"')
+                    return syntaxError("string key expected");
+
+                if (!parseString(&key))
+                    return false;
+
+                if (getToken() != ':')
+                    return syntaxError("':' expected");
+
+                int match = -1;
+                bool several = false;
+
+                for (int j = next; j < end; j = m_program[j].end) {
+                    if (*m_program[j].key == key) {
+                        several = (match >= 0);
+                        if (match < 0) match = j;
+                    }
+                }
+
+                if (match == next && !several) {
+                    path.pushKey(*m_program[match].key);
+
+                    if (!value(match + 1, m_program[match].end))
+                        return false;
+
+                    path.pop();
+                    next = m_program[next].end;
+
+                    if (!runPending(next, end, pending, false))
+                        return false;
+
+                } else if (match >= 0) {
+                    QJsonValue v;
+                    if (!build(v))
+                        return false;
+
+                    for (int j = match; j < end; j = m_program[j].end) {
+                        const auto isPending = std::any_of(pending.cbegin(), pending.cend(), [j](const auto& x) { return x.first == j; });
+                        if (*m_program[j].key == key && !isPending)
+                            pending.emplace_back(j, v);
+                    }
+
+                } else {
+                    if (!skip())
+                        return false;
+                }
+
+                const auto c = getToken();
+                if (c == '}') break;
+                if (c != ',') return syntaxError("',' or '}' expected");
+            }
+        }
+
+        m_depth--;
+        return runPending(next, end, pending, true);
+    }
+
+    // Runs fields from `next`, which are pending or (if object is finished) missing
+    bool runPending(int& next, int end, std::vector<std::pair<int, QJsonValue>>& pending, bool finished)
+    {
+        while (next < end) {
+            const auto it = std::find_if(pending.cbegin(), pending.cend(), [next](const auto& x) { return x.first == next; });
+
+            if (it == pending.cend() && !finished)
+                break;
+
+            const auto obj = (it == pending.cend()) ? QJsonObject() : QJsonObject{{*m_program[next].key, it->second}};
+
+            if (!m_interpreter.run(next, m_logger, obj))
+                return false;
+
+            next = m_program[next].end;
+        }
+
+        return true;
+    }
+
+    // --- Parsing ---
+    bool enter()
+    {
+        m_source.get(); // '{' or '['
+
+        if (++m_depth > MaxDepth)
+            return syntaxError("too deep nesting");
+
+        return true;
+    }
+
+    bool build(QJsonValue& result)
+    {
+        const auto c = peekToken();
+
+        if (c == '[') {
+            if (!enter())
+                return false;
+
+            QJsonArray array;
+
+            if (peekToken() == ']') {
+                m_source.get();
+            } else {
+                for (;;) {
+                    QJsonValue item;
+                    if (!build(item))
+                        return false;
+
+                    array.append(item);
+
+                    const auto delimiter = getToken();
+                    if (delimiter == ']') break;
+                    if (delimiter != ',') return syntaxError("',' or ']' expected");
+                }
+            }
+
+            m_depth--;
+            result = array;
+            return true;
+        }
+
+        if (c == '{') {
+            if (!enter())
+                return false;
+
+            QJsonObject obj;
+            QString key;
+
+            if (peekToken() == '}') {
+                m_source.get();
+            } else {
+                for (;;) {
+                    if (getToken() != '"')
+                        return syntaxError("string key expected");
+
+                    if (!parseString(&key))
+                        return false;
+
+                    if (getToken() != ':')
+                        return syntaxError("':' expected");
+
+                    QJsonValue item;
+                    if (!build(item))
+                        return false;
+
+                    if (!obj.contains(key)) // First value wins, as in streamObject
+                        obj.insert(key, item);
+
+                    const auto delimiter = getToken();
+                    if (delimiter == '}') break;
+                    if (delimiter != ',') return syntaxError("',' or '}' expected");
+                }
+            }
+
+            m_depth--;
+            result = obj;
+            return true;
+        }
+
+        return parseScalar(&result);
+    }
+
+    // Checks syntax only. Counts items, if it's an array
+    bool skip(qsizetype* length = nullptr)
+    {
+        const auto c = peekToken();
+
+        if (c != '[' && c != '{')
+            return parseScalar(nullptr);
+
+        const auto close = (c == '[') ? ']' : '}';
+
+        if (!enter())
+            return false;
+
+        if (peekToken() == close) {
+            m_source.get();
+            m_depth--;
+            return true;
+        }
+
+        for (qsizetype count = 1;; count++) {
+            if (close == '}') {
+                if (getToken() != '"')
+                    return syntaxError("string key expected");
+
+                if (!parseString(nullptr))
+                    return false;
+
+                if (getToken() != ':')
+                    return syntaxError("':' expected");
+            }
+
+            if (!skip())
+                return false;
+
+            const auto delimiter = getToken();
+
+            if (delimiter == close) {
+                if (length)
+                    *length = count;
+                break;
+            }
+
+            if (delimiter != ',')
+                return syntaxError(close == ']' ? "',' or ']' expected" : "',' or '}' expected");
+        }
+
+        m_depth--;
+        return true;
+    }
+
+    bool parseScalar(QJsonValue* result)
+    {
+        const auto c = peekToken();
+
+        if (c == '"') {
+            m_source.get();
+            QString str;
+            if (!parseString(result ? &str : nullptr))
+                return false;
+
+            if (result)
+                *result = str;
+            return true;
+        }
+
+        if (c == '-' || (c >= '0' && c <= '9'))
+            return parseNumber(result);
+
+        if (c == 't') return parseLiteral("true", QJsonValue(true), result);
+        if (c == 'f') return parseLiteral("false", QJsonValue(false), result);
+        if (c == 'n') return parseLiteral("null", QJsonValue(QJsonValue::Type::Null), result);
+
+        return syntaxError(c < 0 ? "unexpected end of data" : "value expected");
+    }
+
+    bool parseLiteral(const char* literal, const QJsonValue& value, QJsonValue* result)
+    {
+        for (auto p = literal; *p; p++)
+            if (m_source.get() != *p)
+                return syntaxError("invalid literal");
+
+        if (result)
+            *result = value;
+        return true;
+    }
+
+    // Integers are kept as qint64, as QJsonDocument does
+    bool parseNumber(QJsonValue* result)
+    {
+        m_scratch.clear();
+        bool integral = true;
+
+        auto digits = [this]() {
+            int count = 0;
+            for (auto c = m_source.peek(); c >= '0' && c <= '9'; c = m_source.peek(), count++)
+                m_scratch.append(static_cast<char>(m_source.get()));
+            return count;
+        };
+
+        if (m_source.peek() == '-')
+            m_scratch.append(static_cast<char>(m_source.get()));
+
+        if (m_source.peek() == '0') {
+            m_scratch.append(static_cast<char>(m_source.get()));
+        } else if (!digits()) {
+            return syntaxError("invalid number");
+        }
+
+        if (m_source.peek() == '.') {
+            integral = false;
+            m_scratch.append(static_cast<char>(m_source.get()));
+            if (!digits())
+                return syntaxError("invalid number");
+        }
+
+        if (m_source.peek() == 'e' || m_source.peek() == 'E') {
+            integral = false;
+            m_scratch.append(static_cast<char>(m_source.get()));
+
+            if (m_source.peek() == '+' || m_source.peek() == '-')
+                m_scratch.append(static_cast<char>(m_source.get()));
+
+            if (!digits())
+                return syntaxError("invalid number");
+        }
+
+        if (!result)
+            return true;
+
+        bool ok = false;
+
+        if (integral) {
+            const auto number = m_scratch.toLongLong(&ok);
+            if (ok) {
+                *result = QJsonValue(static_cast<qint64>(number));
+                return true;
+            }
+        }
+
+        const auto number = m_scratch.toDouble(&ok);
+        if (!ok)
+            return syntaxError("number is out of range");
+
+        *result = number;
+        return true;
+    }
+
+    // Opening quote is already read
+    bool parseString(QString* result)
+    {
+        m_scratch.clear();
+
+        for (;;) {
+            auto c = m_source.get();
+
+            if (c == '"')
+                break;
+
+            if (c < 0)
+                return syntaxError("unterminated string");
+
+            if (c < 0x20)
+                return syntaxError("control character in string");
+
+            if (c != '\\') {
+                if (result)
+                    m_scratch.append(static_cast<char>(c));
+                continue;
+            }
+
+            c = m_source.get();
+
+            switch (c) {
+                case '"':
+                case '\\':
+                case '/': break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'n': c = '\n'; break;
+                case 'r': c = '\r'; break;
+                case 't': c = '\t'; break;
+
+                case 'u': {
+                    char32_t code {};
+                    if (!parseHex4(code))
+                        return false;
+
+                    if (code >= 0xD800 && code <= 0xDBFF) {
+                        char32_t low {};
+                        if (m_source.get() != '\\' || m_source.get() != 'u' || !parseHex4(low) || low < 0xDC00 || low > 0xDFFF)
+                            return syntaxError("invalid surrogate pair");
+
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    } else if (code >= 0xDC00 && code <= 0xDFFF) {
+                        return syntaxError("invalid surrogate pair");
+                    }
+
+                    if (result)
+                        appendUtf8(code);
+                    continue;
+                }
+
+                default:
+                    return syntaxError("invalid escape sequence");
+            }
+
+            if (result)
+                m_scratch.append(static_cast<char>(c));
+        }
+
+        if (result)
+            *result = QString::fromUtf8(m_scratch);
+
+        return true;
+    }
+
+    bool parseHex4(char32_t& code)
+    {
+        code = 0;
+
+        for (int i = 0; i < 4; i++) {
+            const auto c = m_source.get();
+            const auto digit = (c >= '0' && c <= '9') ? c - '0' :
+                               (c >= 'a' && c <= 'f') ? c - 'a' + 10 :
+                               (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+            if (digit < 0)
+                return syntaxError("invalid unicode escape");
+
+            code = (code << 4) | static_cast<char32_t>(digit);
+        }
+
+        return true;
+    }
+
+    void appendUtf8(char32_t code)
+    {
+        if (code < 0x80) {
+            m_scratch.append(static_cast<char>(code));
+        } else if (code < 0x800) {
+            m_scratch.append(static_cast<char>(0xC0 | (code >> 6)));
+            m_scratch.append(static_cast<char>(0x80 | (code & 0x3F)));
+        } else if (code < 0x10000) {
+            m_scratch.append(static_cast<char>(0xE0 | (code >> 12)));
+            m_scratch.append(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            m_scratch.append(static_cast<char>(0x80 | (code & 0x3F)));
+        } else {
+            m_scratch.append(static_cast<char>(0xF0 | (code >> 18)));
+            m_scratch.append(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+            m_scratch.append(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            m_scratch.append(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+    }
+
+    int peekToken()
+    {
+        for (auto c = m_source.peek();; c = m_source.peek()) {
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+                return c;
+
+            m_source.get();
+        }
+    }
+
+    int getToken()
+    {
+        peekToken();
+        return m_source.get();
+    }
+
+    bool syntaxError(const char* description)
+    {
+        m_logger.notifyError(m_interpreter.m_path, QString("Invalid JSON at offset %1: %2").arg(m_source.offset()).arg(description));
+        return false;
+    }
+
+private:
+    const std::vector<Instruction>& m_program;
+    Interpreter m_interpreter;
+    ErrorInfo& m_logger;
+    ByteSource& m_source;
+    QByteArray m_scratch;
+    int m_depth {};
+};
+
+} // namespace Internal
+
+struct CompiledValidator::impl_t
+{
+    Internal::RootValidatorCPtr root;
+    std::vector<Internal::Instruction> program;
+};
+
+CompiledValidator::CompiledValidator(const Internal::RootValidatorCPtr& root)
+{
+    assert(root);
+    createImpl();
+    impl().root = root;
+    impl().program = Internal::Compiler::compile(*root);
+}
+
+CompiledValidator::~CompiledValidator()
+{
+}
+
+bool CompiledValidator::check(ErrorInfo& logger, const QJsonValue& value, const ParallelOptions& parallel) const
+{
+    ContextData ctx;
+    return check(ctx, logger, value, parallel);
+}
+
+bool CompiledValidator::check(ContextData& ctx, ErrorInfo& logger, const QJsonValue& value, const ParallelOptions& parallel) const
+{
+    return Internal::Interpreter(impl().program, ctx, logger, &parallel).run(0, value);
+}
+
+bool CompiledValidator::checkUtf8(ErrorInfo& logger, const QByteArray& utf8) const
+{
+    ContextData ctx;
+    return checkUtf8(ctx, logger, utf8);
+}
+
+bool CompiledValidator::checkUtf8(ContextData& ctx, ErrorInfo& logger, const QByteArray& utf8) const
+{
+    Internal::ByteSource source(utf8.constData(), utf8.size());
+    return Internal::StreamInterpreter(impl().program, ctx, logger, source).run();
+}
+
+bool CompiledValidator::checkDevice(ErrorInfo& logger, QIODevice& device) const
+{
+    ContextData ctx;
+    return checkDevice(ctx, logger, device);
+}
+
+bool CompiledValidator::checkDevice(ContextData& ctx, ErrorInfo& logger, QIODevice& device) const
+{
+    if (!device.isReadable()) {
+        logger.notifyError(QString(), "Device isn't open for reading");
+        return false;
+    }
+
+    Internal::ByteSource source(device);
+    return Internal::StreamInterpreter(impl().program, ctx, logger, source).run();
+}
+
+bool CompiledValidator::checkFile(ErrorInfo& logger, const QString& fileName, FileAccess access) const
+{
+    ContextData ctx;
+    return checkFile(ctx, logger, fileName, access);
+}
+
+bool CompiledValidator::checkFile(ContextData& ctx, ErrorInfo& logger, const QString& fileName, FileAccess access) const
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        logger.notifyError(QString(), "Failed to open file \"" + fileName + "\": " + file.errorString());
+        return false;
+    }
+
+    const auto size = file.size();
+
+    if (access == FileAccess::MemoryMapped && size > 0) {
+        if (const auto data = file.map(0, size)) {
+            Internal::ByteSource source(reinterpret_cast<const char*>(data), size);
+            const auto result = Internal::StreamInterpreter(impl().program, ctx, logger, source).run();
+            file.unmap(data);
+            return result;
+        }
+    }
+
+    return checkDevice(ctx, logger, file);
+}
+
+size_t CompiledValidator::instructionsCount() const
+{
+    return impl().program.size();
+}
+
+CompiledValidatorCPtr Compile(const RootValidatorCPtr& root)
+{
+    return std::make_shared<CompiledValidator>(root);
+}
+// --- ---
+
 ValidatorCPtr CtxWriteArrayLength(const QString& ctxField) { return std::make_shared<Internal::CtxWriteArrayLength>(ctxField); }
 ValidatorCPtr CtxCheckArrayLength(const QString& ctxField) { return std::make_shared<Internal::CtxCheckArrayLength>(ctxField); }
 ValidatorCPtr CtxAppendToList(const QString& ctxField) { return std::make_shared<Internal::CtxAppendToList>(ctxField); }
@@ -0,0 +1,179 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/utils-qt
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <UtilsQt/OnProperty.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <QElapsedTimer>
+
+namespace UtilsQt {
+namespace OnPropertyInternal {
+
+namespace {
+
+// Process-wide: multiplexer is a child of the object, so after `moveToThread` it's destroyed
+// (and found by `onProperty`) in another thread than where it was created.
+struct MultiplexersRegistry
+{
+    std::mutex mutex;
+    std::unordered_map<QObject*, std::vector<MultiplexerBase*>> multiplexers;
+};
+
+MultiplexersRegistry& multiplexersRegistry()
+{
+    static MultiplexersRegistry registry;
+    return registry;
+}
+
+} // namespace
+
+struct TimerWheel::impl_t
+{
+    static constexpr int TickMs = 10;
+    static constexpr size_t SlotsCount = 256;
+
+    struct Entry
+    {
+        quint64 id;
+        quint64 rounds;
+    };
+
+    std::array<std::vector<Entry>, SlotsCount> slots;
+    std::unordered_map<quint64, Callback> callbacks;
+    size_t currentSlot {0};
+    quint64 nextId {1};
+
+    QTimer timer;
+    QElapsedTimer elapsed;
+    qint64 processedTicks {0};
+};
+
+TimerWheel& TimerWheel::instance()
+{
+    thread_local TimerWheel wheel;
+    return wheel;
+}
+
+TimerWheel::TimerWheel()
+{
+    createImpl();
+    impl().timer.setInterval(impl_t::TickMs);
+    QObject::connect(&impl().timer, &QTimer::timeout, this, &TimerWheel::tick);
+}
+
+TimerWheel::~TimerWheel()
+{
+}
+
+quint64 TimerWheel::schedule(int timeoutMs, const Callback& callback)
+{
+    assert(timeoutMs > 0);
+
+    if (!impl().timer.isActive()) {
+        impl().elapsed.start();
+        impl().processedTicks = 0;
+        impl().timer.start();
+    }
+
+    // +1 tick, because current tick is partially elapsed, and + ticks which aren't processed yet
+    const auto lag = impl().elapsed.elapsed() / impl_t::TickMs - impl().processedTicks;
+    const auto ticks = static_cast<quint64>(timeoutMs / impl_t::TickMs + 1 + std::max<qint64>(lag, 0));
+    const auto id = impl().nextId++;
+
+    impl().slots[(impl().currentSlot + ticks) % impl_t::SlotsCount].push_back({id, (ticks - 1) / impl_t::SlotsCount});
+    impl().callbacks.emplace(id, callback);
+
+    return id;
+}
+
+void TimerWheel::cancel(quint64 id)
+{
+    // Entry in the slot is dropped lazily
+    impl().callbacks.erase(id);
+
+    if (impl().callbacks.empty())
+        impl().timer.stop();
+}
+
+void TimerWheel::tick()
+{
+    // Catch up, if event loop was busy
+    const auto targetTicks = impl().elapsed.elapsed() / impl_t::TickMs;
+
+    while (impl().processedTicks < targetTicks && !impl().callbacks.empty()) {
+        impl().processedTicks++;
+        impl().currentSlot = (impl().currentSlot + 1) % impl_t::SlotsCount;
+
+        auto& slot = impl().slots[impl().currentSlot];
+        std::vector<Callback> due;
+        size_t kept = 0;
+
+        for (auto& entry : slot) {
+            const auto it = impl().callbacks.find(entry.id);
+
+            if (it == impl().callbacks.end())
+                continue; // Canceled
+
+            if (entry.rounds) {
+                entry.rounds--;
+                slot[kept++] = entry;
+                continue;
+            }
+
+            due.push_back(std::move(it->second));
+            impl().callbacks.erase(it);
+        }
+
+        slot.resize(kept);
+
+        // Callbacks can schedule or cancel other timers
+        for (const auto& callback : due)
+            callback();
+    }
+
+    if (impl().callbacks.empty())
+        impl().timer.stop();
+}
+
+
+MultiplexerBase::MultiplexerBase(QObject* object, int signalIndex)
+    : QObject(object),
+      m_object(object),
+      m_signalIndex(signalIndex)
+{
+    auto& registry = multiplexersRegistry();
+    std::lock_guard lock(registry.mutex);
+    registry.multiplexers[object].push_back(this);
+}
+
+MultiplexerBase::~MultiplexerBase()
+{
+    auto& registry = multiplexersRegistry();
+    std::lock_guard lock(registry.mutex);
+    const auto it = registry.multiplexers.find(m_object);
+    assert(it != registry.multiplexers.end());
+
+    if (it == registry.multiplexers.end())
+        return;
+
+    auto& list = it->second;
+    list.erase(std::remove(list.begin(), list.end(), this), list.end());
+
+    if (list.empty())
+        registry.multiplexers.erase(it);
+}
+
+std::vector<MultiplexerBase*> MultiplexerBase::multiplexersOf(QObject* object)
+{
+    auto& registry = multiplexersRegistry();
+    std::lock_guard lock(registry.mutex);
+    const auto it = registry.multiplexers.find(object);
+    return it == registry.multiplexers.end() ? std::vector<MultiplexerBase*>() : it->second;
+}
+
+} // namespace OnPropertyInternal
+} // namespace UtilsQt
@@ -5,6 +5,9 @@
 #include <UtilsQt/Qml-Cpp/Geometry/Geometry.h>
 
 #include <QQmlEngine>
+#include <cmath>
+#include "GeometryKernels.h"
+#include "PolygonEdgeIndex.h"
 
 struct Geometry::impl_t
 {
@@ -50,10 +53,7 @@ QVector<QPolygonF> Geometry::polygonsScale(const QVector<QPolygonF>& polygons, q
 
 void Geometry::polygonScaleRef(QPolygonF& polygon, qreal xFactor, qreal yFactor) const
 {
-    for (auto& p : polygon) {
-        p.rx() *= xFactor;
-        p.ry() *= yFactor;
-    }
+    GeometryInternal::transformPoints(polygon.data(), polygon.size(), GeometryInternal::ScaleOp{xFactor, yFactor});
 }
 
 void Geometry::polygonsScaleRef(QVector<QPolygonF>& polygons, qreal xFactor, qreal yFactor) const
@@ -62,6 +62,72 @@ void Geometry::polygonsScaleRef(QVector<QPolygonF>& polygons, qreal xFactor, qre
         polygonScaleRef(polygon, xFactor, yFactor);
 }
 
+QVector<QPolygonF> Geometry::polygonsTranslate(const QVector<QPolygonF>& polygons, qreal dx, qreal dy) const
+{
+    auto result = polygons;
+    polygonsTranslateRef(result, dx, dy);
+    return result;
+}
+
+QVector<QPolygonF> Geometry::polygonsTransform(const QVector<QPolygonF>& polygons, const QTransform& transform) const
+{
+    auto result = polygons;
+    polygonsTransformRef(result, transform);
+    return result;
+}
+
+QRectF Geometry::polygonsTranslateRef(QVector<QPolygonF>& polygons, qreal dx, qreal dy) const
+{
+    GeometryInternal::Bounds bounds;
+
+    for (auto& polygon : polygons)
+        GeometryInternal::transformPoints(polygon.data(), polygon.size(), GeometryInternal::TranslateOp{dx, dy}, &bounds);
+
+    return bounds.toRect();
+}
+
+QRectF Geometry::polygonsTransformRef(QVector<QPolygonF>& polygons, const QTransform& transform) const
+{
+    switch (transform.type()) {
+        case QTransform::TxNone:
+            return polygonsBoundingRect(polygons);
+
+        case QTransform::TxTranslate:
+            return polygonsTranslateRef(polygons, transform.dx(), transform.dy());
+
+        case QTransform::TxScale:
+        case QTransform::TxRotate:
+        case QTransform::TxShear: {
+            const GeometryInternal::AffineOp op(transform);
+            GeometryInternal::Bounds bounds;
+
+            for (auto& polygon : polygons)
+                GeometryInternal::transformPoints(polygon.data(), polygon.size(), op, &bounds);
+
+            return bounds.toRect();
+        }
+
+        case QTransform::TxProject:
+            break;
+    }
+
+    // Perspective: not a linear operation, leave it to Qt
+    for (auto& polygon : polygons)
+        polygon = transform.map(polygon);
+
+    return polygonsBoundingRect(polygons);
+}
+
+QRectF Geometry::polygonsBoundingRect(const QVector<QPolygonF>& polygons) const
+{
+    GeometryInternal::Bounds bounds;
+
+    for (const auto& polygon : polygons)
+        GeometryInternal::addPoints(polygon.constData(), polygon.size(), bounds);
+
+    return bounds.toRect();
+}
+
 bool Geometry::isPolygonRectangular(const QPolygonF& polygon) const
 {
     double area = 0.0;
@@ -70,7 +136,34 @@ bool Geometry::isPolygonRectangular(const QPolygonF& polygon) const
         area += (polygon[j].x() + polygon[i].x()) * (polygon[j].y() - polygon[i].y());
         j = i;
     }
-    auto polygonArea = abs(area / 2.0);
-    auto boundingRectArea = polygon.boundingRect().width() * polygon.boundingRect().height();
+    auto polygonArea = std::abs(area / 2.0);
+
+    GeometryInternal::Bounds bounds;
+    GeometryInternal::addPoints(polygon.constData(), polygon.size(), bounds);
+    const auto boundingRect = bounds.toRect();
+
+    auto boundingRectArea = boundingRect.width() * boundingRect.height();
     return qFuzzyCompare(polygonArea, boundingRectArea);
 }
+
+QVector<int> Geometry::pointsInPolygon(const QPolygonF& polygon, const QVector<QPointF>& points, Qt::FillRule fillRule) const
+{
+    QVector<int> result;
+
+    // Indexing pays off for many points against many edges only
+    if (polygon.size() < 16 || points.size() < 16) {
+        for (int i = 0; i < points.size(); i++)
+            if (polygon.containsPoint(points[i], fillRule))
+                result.append(i);
+
+        return result;
+    }
+
+    const GeometryInternal::PolygonEdgeIndex index(polygon);
+
+    for (int i = 0; i < points.size(); i++)
+        if (index.containsPoint(points[i], fillRule))
+            result.append(i);
+
+    return result;
+}
@@ -0,0 +1,175 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/utils-qt
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <QPointF>
+#include <QRectF>
+#include <QTransform>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTILS_QT_GEOMETRY_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// Kernels over contiguous point buffers. With SSE2 (and qreal == double) each QPointF is processed
+// as one 128-bit register, otherwise plain loops are used.
+
+namespace GeometryInternal {
+
+static_assert(sizeof(QPointF) == 2 * sizeof(qreal), "QPointF is expected to be {x, y}");
+
+constexpr bool UseSse2 =
+#ifdef UTILS_QT_GEOMETRY_SSE2
+    std::is_same_v<qreal, double>;
+#else
+    false;
+#endif
+
+// Running min/max of points, empty until the first point
+struct Bounds
+{
+    qreal minX { std::numeric_limits<qreal>::max() };
+    qreal minY { std::numeric_limits<qreal>::max() };
+    qreal maxX { std::numeric_limits<qreal>::lowest() };
+    qreal maxY { std::numeric_limits<qreal>::lowest() };
+
+    bool isEmpty() const { return minX > maxX; }
+    QRectF toRect() const { return isEmpty() ? QRectF() : QRectF(QPointF(minX, minY), QPointF(maxX, maxY)); }
+
+    void add(qreal x, qreal y)
+    {
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+};
+
+struct ScaleOp
+{
+    qreal sx;
+    qreal sy;
+
+    void operator()(qreal& x, qreal& y) const { x *= sx; y *= sy; }
+#ifdef UTILS_QT_GEOMETRY_SSE2
+    __m128d operator()(__m128d p, __m128d factors) const { return _mm_mul_pd(p, factors); }
+    __m128d prepare() const { return _mm_set_pd(sy, sx); }
+#endif
+};
+
+struct TranslateOp
+{
+    qreal dx;
+    qreal dy;
+
+    void operator()(qreal& x, qreal& y) const { x += dx; y += dy; }
+#ifdef UTILS_QT_GEOMETRY_SSE2
+    __m128d operator()(__m128d p, __m128d offsets) const { return _mm_add_pd(p, offsets); }
+    __m128d prepare() const { return _mm_set_pd(dy, dx); }
+#endif
+};
+
+// x' = m11 * x + m21 * y + dx
+// y' = m12 * x + m22 * y + dy
+struct AffineOp
+{
+    explicit AffineOp(const QTransform& t)
+        : m11(t.m11()), m12(t.m12()), m21(t.m21()), m22(t.m22()), dx(t.dx()), dy(t.dy())
+    { }
+
+    qreal m11, m12, m21, m22, dx, dy;
+
+    void operator()(qreal& x, qreal& y) const
+    {
+        const auto nx = m11 * x + m21 * y + dx;
+        y = m12 * x + m22 * y + dy;
+        x = nx;
+    }
+
+#ifdef UTILS_QT_GEOMETRY_SSE2
+    struct Constants { __m128d column1, column2, offsets; };
+
+    Constants prepare() const { return {_mm_set_pd(m12, m11), _mm_set_pd(m22, m21), _mm_set_pd(dy, dx)}; }
+
+    __m128d operator()(__m128d p, const Constants& c) const
+    {
+        const auto xx = _mm_unpacklo_pd(p, p);
+        const auto yy = _mm_unpackhi_pd(p, p);
+        return _mm_add_pd(_mm_add_pd(_mm_mul_pd(xx, c.column1), _mm_mul_pd(yy, c.column2)), c.offsets);
+    }
+#endif
+};
+
+// Transforms points in place. If `bounds` is set, it's extended by the resulting points in the same pass.
+template<typename Op>
+void transformPoints(QPointF* points, qsizetype count, const Op& op, Bounds* bounds = nullptr)
+{
+#ifdef UTILS_QT_GEOMETRY_SSE2
+    if constexpr (UseSse2) {
+        auto data = reinterpret_cast<double*>(points);
+        const auto constants = op.prepare();
+
+        if (!bounds) {
+            for (qsizetype i = 0; i < count; i++)
+                _mm_storeu_pd(data + 2 * i, op(_mm_loadu_pd(data + 2 * i), constants));
+            return;
+        }
+
+        auto low = _mm_set_pd(bounds->minY, bounds->minX);
+        auto high = _mm_set_pd(bounds->maxY, bounds->maxX);
+
+        for (qsizetype i = 0; i < count; i++) {
+            const auto p = op(_mm_loadu_pd(data + 2 * i), constants);
+            _mm_storeu_pd(data + 2 * i, p);
+            low = _mm_min_pd(low, p);
+            high = _mm_max_pd(high, p);
+        }
+
+        _mm_storel_pd(&bounds->minX, low);
+        _mm_storeh_pd(&bounds->minY, low);
+        _mm_storel_pd(&bounds->maxX, high);
+        _mm_storeh_pd(&bounds->maxY, high);
+        return;
+    }
+#endif
+
+    for (qsizetype i = 0; i < count; i++) {
+        auto& p = points[i];
+        op(p.rx(), p.ry());
+
+        if (bounds)
+            bounds->add(p.x(), p.y());
+    }
+}
+
+inline void addPoints(const QPointF* points, qsizetype count, Bounds& bounds)
+{
+#ifdef UTILS_QT_GEOMETRY_SSE2
+    if constexpr (UseSse2) {
+        auto data = reinterpret_cast<const double*>(points);
+        auto low = _mm_set_pd(bounds.minY, bounds.minX);
+        auto high = _mm_set_pd(bounds.maxY, bounds.maxX);
+
+        for (qsizetype i = 0; i < count; i++) {
+            const auto p = _mm_loadu_pd(data + 2 * i);
+            low = _mm_min_pd(low, p);
+            high = _mm_max_pd(high, p);
+        }
+
+        _mm_storel_pd(&bounds.minX, low);
+        _mm_storeh_pd(&bounds.minY, low);
+        _mm_storel_pd(&bounds.maxX, high);
+        _mm_storeh_pd(&bounds.maxY, high);
+        return;
+    }
+#endif
+
+    for (qsizetype i = 0; i < count; i++)
+        bounds.add(points[i].x(), points[i].y());
+}
+
+} // namespace GeometryInternal
@@ -8,15 +8,207 @@
 #include <QVector>
 #include <QPolygonF>
 #include <QVariantList>
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <vector>
+#include "PolygonEdgeIndex.h"
 
+namespace {
+
+// Inclusive, unlike QRectF::intersects (which is false for zero-size rects)
+bool overlaps(const QRectF& a, const QRectF& b)
+{
+    return a.left() <= b.right() && b.left() <= a.right() &&
+           a.top() <= b.bottom() && b.top() <= a.bottom();
+}
+
+bool containsRect(const QRectF& outer, const QRectF& inner)
+{
+    return outer.left() <= inner.left() && inner.right() <= outer.right() &&
+           outer.top() <= inner.top() && inner.bottom() <= outer.bottom();
+}
+
+struct Entry
+{
+    static constexpr int EdgeIndexThreshold = 32; // Points
+
+    explicit Entry(const QPolygonF& polygon)
+        : polygon(polygon),
+          bounds(polygon.boundingRect())
+    {
+        if (polygon.size() >= EdgeIndexThreshold)
+            edges.emplace(polygon);
+    }
+
+    bool containsPoint(const QPointF& point) const
+    {
+        if (!overlaps(bounds, QRectF(point, point)))
+            return false;
+
+        return edges ? edges->containsPoint(point, Qt::FillRule::OddEvenFill) :
+                       polygon.containsPoint(point, Qt::FillRule::OddEvenFill);
+    }
+
+    QPolygonF polygon;
+    QRectF bounds;
+    std::optional<GeometryInternal::PolygonEdgeIndex> edges;
+};
+
+// Uniform grid over bounding rects of polygons. Each cell lists polygons, whose bounds overlap it.
+class PolygonGrid
+{
+public:
+    void build(const std::vector<Entry>& entries)
+    {
+        m_offsets.clear();
+        m_indexes.clear();
+        m_entryCells.clear();
+
+        if (entries.empty())
+            return;
+
+        auto left = entries.front().bounds.left();
+        auto top = entries.front().bounds.top();
+        auto right = entries.front().bounds.right();
+        auto bottom = entries.front().bounds.bottom();
+
+        for (const auto& x : entries) {
+            left = std::min(left, x.bounds.left());
+            top = std::min(top, x.bounds.top());
+            right = std::max(right, x.bounds.right());
+            bottom = std::max(bottom, x.bounds.bottom());
+        }
+
+        m_bounds = QRectF(QPointF(left, top), QPointF(right, bottom));
+
+        // About one polygon per cell
+        const auto side = std::clamp(static_cast<int>(std::ceil(std::sqrt(entries.size()))), 1, MaxSide);
+        m_columns = m_bounds.width() > 0 ? side : 1;
+        m_rows = m_bounds.height() > 0 ? side : 1;
+        m_cellWidth = m_bounds.width() > 0 ? m_bounds.width() / m_columns : 1;
+        m_cellHeight = m_bounds.height() > 0 ? m_bounds.height() / m_rows : 1;
+
+        // Compressed rows: counts, offsets, then indexes
+        m_offsets.assign(m_columns * m_rows + 1, 0);
+        m_entryCells.reserve(entries.size());
+
+        for (const auto& x : entries) {
+            const auto cells = cellRange(x.bounds);
+            m_entryCells.push_back(cells);
+
+            for (int cy = cells.y0; cy <= cells.y1; cy++)
+                for (int cx = cells.x0; cx <= cells.x1; cx++)
+                    m_offsets[cy * m_columns + cx + 1]++;
+        }
+
+        for (size_t i = 1; i < m_offsets.size(); i++)
+            m_offsets[i] += m_offsets[i - 1];
+
+        m_indexes.resize(m_offsets.back());
+        auto fill = m_offsets;
+
+        for (int i = 0; i < static_cast<int>(entries.size()); i++) {
+            const auto& cells = m_entryCells[i];
+
+            for (int cy = cells.y0; cy <= cells.y1; cy++)
+                for (int cx = cells.x0; cx <= cells.x1; cx++)
+                    m_indexes[fill[cy * m_columns + cx]++] = i;
+        }
+    }
+
+    // Calls `func(index)` for polygons from point's cell, until it returns true
+    template<typename Func>
+    bool anyAt(const QPointF& point, const Func& func) const
+    {
+        if (m_indexes.empty() || !overlaps(m_bounds, QRectF(point, point)))
+            return false;
+
+        const auto cell = cellY(point.y()) * m_columns + cellX(point.x());
+
+        for (int j = m_offsets[cell]; j < m_offsets[cell + 1]; j++)
+            if (func(m_indexes[j]))
+                return true;
+
+        return false;
+    }
+
+    // Calls `func(index)` once for each polygon from rect's cells, until it returns true
+    template<typename Func>
+    bool anyIn(const QRectF& rect, const Func& func) const
+    {
+        if (m_indexes.empty() || !overlaps(m_bounds, rect))
+            return false;
+
+        const auto cells = cellRange(rect);
+
+        for (int cy = cells.y0; cy <= cells.y1; cy++) {
+            for (int cx = cells.x0; cx <= cells.x1; cx++) {
+                const auto cell = cy * m_columns + cx;
+
+                for (int j = m_offsets[cell]; j < m_offsets[cell + 1]; j++) {
+                    const auto index = m_indexes[j];
+                    const auto& entryCells = m_entryCells[index];
+
+                    // Visit polygon in the first common cell only
+                    if (cx != std::max(cells.x0, entryCells.x0) || cy != std::max(cells.y0, entryCells.y0))
+                        continue;
+
+                    if (func(index))
+                        return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+private:
+    struct CellRange
+    {
+        int x0, y0, x1, y1;
+    };
+
+    int cellX(qreal x) const { return toCell((x - m_bounds.left()) / m_cellWidth, m_columns); }
+    int cellY(qreal y) const { return toCell((y - m_bounds.top()) / m_cellHeight, m_rows); }
+
+    static int toCell(qreal position, int count)
+    {
+        return static_cast<int>(std::clamp(std::floor(position), qreal(0), qreal(count - 1)));
+    }
+
+    CellRange cellRange(const QRectF& rect) const
+    {
+        return {cellX(rect.left()), cellY(rect.top()), cellX(rect.right()), cellY(rect.bottom())};
+    }
+
+private:
+    static constexpr int MaxSide = 64;
+
+    QRectF m_bounds;
+    int m_columns {};
+    int m_rows {};
+    qreal m_cellWidth {};
+    qreal m_cellHeight {};
+    std::vector<int> m_offsets;
+    std::vector<int> m_indexes;
+    std::vector<CellRange> m_entryCells;
+};
+
+} // namespace
+
+// Polygons are kept in their own coordinates, queries are translated by -offset instead.
+// So offset changes don't require recalculation.
 struct Polygon::impl_t
 {
-    QPolygonF combinedPolygon;
-    QVector<QPolygonF> translatedPolygons;
+    std::vector<Entry> entries;
+    PolygonGrid grid;
 
     QVector<QPolygonF> polygons;
     QPointF offset;
     bool negativeOffset { false };
+
+    QPointF effectiveOffset() const { return offset * (negativeOffset ? -1 : 1); }
 };
 
 void Polygon::registerTypes()
@@ -36,18 +228,48 @@ Polygon::~Polygon()
 
 bool Polygon::intersectsWithPoint(const QPointF& value) const
 {
-    return impl().combinedPolygon.containsPoint(value, Qt::FillRule::OddEvenFill);
+    const auto point = value - impl().effectiveOffset();
+
+    return impl().grid.anyAt(point, [this, &point](int index) {
+        return impl().entries[index].containsPoint(point);
+    });
+}
+
+QVector<int> Polygon::intersectingPoints(const QVector<QPointF>& values) const
+{
+    const auto offset = impl().effectiveOffset();
+    QVector<int> result;
+
+    for (int i = 0; i < values.size(); i++) {
+        const auto point = values[i] - offset;
+
+        const auto found = impl().grid.anyAt(point, [this, &point](int index) {
+            return impl().entries[index].containsPoint(point);
+        });
+
+        if (found)
+            result.append(i);
+    }
+
+    return result;
 }
 
 bool Polygon::intersectsWithRect(const QRectF& value) const
 {
-    const QPolygonF rectPolygon(value);
+    const auto rect = value.normalized().translated(-impl().effectiveOffset());
+    const QPolygonF rectPolygon(rect);
+
+    return impl().grid.anyIn(rect, [this, &rect, &rectPolygon](int index) {
+        const auto& entry = impl().entries[index];
 
-    for (const auto& x : std::as_const(impl().translatedPolygons))
-        if (rectPolygon.intersects(x))
+        if (!overlaps(entry.bounds, rect))
+            return false;
+
+        if (entry.polygon.size() >= 3 && containsRect(rect, entry.bounds))
             return true;
 
-    return false;
+        return rectPolygon.intersects(entry.polygon);
+    });
 }
 
 const QVector<QPolygonF>& Polygon::polygons() const
@@ -74,7 +296,6 @@ void Polygon::setOffset(QPointF value)
     if (impl().offset == value)
         return;
     impl().offset = value;
-    recalculate();
     emit offsetChanged(impl().offset);
 }
 
@@ -88,22 +309,17 @@ void Polygon::setNegativeOffset(bool value)
     if (impl().negativeOffset == value)
         return;
     impl().negativeOffset = value;
-    recalculate();
     emit negativeOffsetChanged(impl().negativeOffset);
 }
 
 void Polygon::recalculate()
 {
-    impl().combinedPolygon.clear();
-    impl().translatedPolygons = impl().polygons;
-
-    const QPointF offset (impl().offset * (impl().negativeOffset ? -1 : 1));
+    impl().entries.clear();
+    impl().entries.reserve(impl().polygons.size());
 
     for (const auto& x : std::as_const(impl().polygons))
-        impl().combinedPolygon = impl().combinedPolygon.united(x);
-
-    impl().combinedPolygon.translate(offset);
+        if (!x.isEmpty())
+            impl().entries.emplace_back(x);
 
-    for (auto& x : impl().translatedPolygons)
-        x.translate(offset);
+    impl().grid.build(impl().entries);
 }
@@ -0,0 +1,128 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/utils-qt
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <QPolygonF>
+#include <QPointF>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace GeometryInternal {
+
+// Edges of a polygon bucketed into horizontal slabs of equal height. Containment test visits only
+// edges crossing the point's slab, instead of all edges. The crossing rule is the same as in
+// QPolygonF::containsPoint, so results are exactly the same.
+class PolygonEdgeIndex
+{
+public:
+    static constexpr int MaxSlabs = 1024;
+
+    explicit PolygonEdgeIndex(const QPolygonF& polygon)
+    {
+        if (polygon.isEmpty())
+            return;
+
+        std::vector<Edge> edges;
+        edges.reserve(polygon.size());
+
+        for (int i = 1; i < polygon.size(); i++)
+            addEdge(edges, polygon[i - 1], polygon[i]);
+
+        // Implicitly closed, as in QPolygonF::containsPoint
+        if (polygon.last() != polygon.first())
+            addEdge(edges, polygon.last(), polygon.first());
+
+        if (edges.empty())
+            return;
+
+        m_top = edges.front().y1;
+        m_bottom = edges.front().y2;
+
+        for (const auto& x : edges) {
+            m_top = std::min(m_top, x.y1);
+            m_bottom = std::max(m_bottom, x.y2);
+        }
+
+        m_slabs = std::clamp(static_cast<int>(edges.size() / 2), 1, MaxSlabs);
+        m_slabHeight = (m_bottom - m_top) / m_slabs;
+
+        // Compressed rows: edges are copied to each slab they cross
+        m_offsets.assign(m_slabs + 1, 0);
+
+        for (const auto& x : edges)
+            for (int s = slab(x.y1), last = slab(x.y2); s <= last; s++)
+                m_offsets[s + 1]++;
+
+        for (size_t i = 1; i < m_offsets.size(); i++)
+            m_offsets[i] += m_offsets[i - 1];
+
+        m_edges.resize(m_offsets.back());
+        auto fill = m_offsets;
+
+        for (const auto& x : edges)
+            for (int s = slab(x.y1), last = slab(x.y2); s <= last; s++)
+                m_edges[fill[s]++] = x;
+    }
+
+    bool containsPoint(const QPointF& point, Qt::FillRule fillRule) const
+    {
+        const auto y = point.y();
+
+        if (m_edges.empty() || y < m_top || y >= m_bottom)
+            return false;
+
+        const auto s = slab(y);
+        int winding = 0;
+
+        for (int j = m_offsets[s]; j < m_offsets[s + 1]; j++) {
+            const auto& e = m_edges[j];
+
+            if (y >= e.y1 && y < e.y2) {
+                const auto x = e.x1 + ((e.x2 - e.x1) / (e.y2 - e.y1)) * (y - e.y1);
+                if (x <= point.x())
+                    winding += e.direction;
+            }
+        }
+
+        return fillRule == Qt::WindingFill ? (winding != 0) : ((winding % 2) != 0);
+    }
+
+private:
+    struct Edge
+    {
+        qreal x1, y1; // Lower y
+        qreal x2, y2;
+        int direction;
+    };
+
+    static void addEdge(std::vector<Edge>& edges, const QPointF& p1, const QPointF& p2)
+    {
+        // Horizontal edges are ignored according to scan conversion rule
+        if (qFuzzyCompare(p1.y(), p2.y()))
+            return;
+
+        if (p2.y() < p1.y()) {
+            edges.push_back({p2.x(), p2.y(), p1.x(), p1.y(), -1});
+        } else {
+            edges.push_back({p1.x(), p1.y(), p2.x(), p2.y(), 1});
+        }
+    }
+
+    int slab(qreal y) const
+    {
+        const auto position = std::floor((y - m_top) / m_slabHeight);
+        return static_cast<int>(std::clamp(position, qreal(0), qreal(m_slabs - 1)));
+    }
+
+private:
+    qreal m_top {};
+    qreal m_bottom {};
+    qreal m_slabHeight {};
+    int m_slabs {};
+    std::vector<int> m_offsets;
+    std::vector<Edge> m_edges;
+};
+
+} // namespace GeometryInternal
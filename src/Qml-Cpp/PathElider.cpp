@@ -7,9 +7,227 @@
 #include <QStringList>
 #include <QQmlEngine>
 #include <QFontMetrics>
+#include <QFontMetricsF>
 #include <QRegularExpression>
+#include <QHash>
+#include <QPair>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <algorithm>
 #include <utils-cpp/middle_iterator.h>
 
+#include "../RunChunked.h"
+
+namespace {
+
+// Widths of path segments (directories, protocols, separators) shared by all elider instances.
+// Paths in a list usually repeat the same directory names, so each of them is measured once per font.
+class SegmentWidthCache
+{
+public:
+    static constexpr int MaxEntries = 65536;
+
+    static SegmentWidthCache& instance()
+    {
+        static SegmentWidthCache cache;
+        return cache;
+    }
+
+    qreal width(const QString& fontKey, const QFontMetricsF& metrics, const QString& segment)
+    {
+        const auto key = qMakePair(fontKey, segment);
+
+        {
+            QMutexLocker locker(&m_mutex);
+            const auto it = m_widths.constFind(key);
+            if (it != m_widths.cend())
+                return it.value();
+        }
+
+        const auto result = metrics.horizontalAdvance(segment);
+
+        QMutexLocker locker(&m_mutex);
+        if (m_widths.size() >= MaxEntries)
+            m_widths.clear();
+        m_widths.insert(key, result);
+
+        return result;
+    }
+
+private:
+    QMutex m_mutex;
+    QHash<QPair<QString, QString>, qreal> m_widths;
+};
+
+// Measures elision candidates. Width of a candidate is first estimated from widths of its segments,
+// real measurement is done only for candidates which are close enough to the limit.
+class CandidateMeasurer
+{
+public:
+    CandidateMeasurer(const QFont& font, int widthLimit)
+        : m_fontKey(font.key()),
+          m_metrics(font),
+          m_metricsF(font),
+          m_widthLimit(widthLimit)
+    { }
+
+    int exactWidth(const QString& text) const { return m_metrics.horizontalAdvance(text); }
+    qreal segmentWidth(const QString& segment) const { return SegmentWidthCache::instance().width(m_fontKey, m_metricsF, segment); }
+    qreal uncachedWidth(const QString& text) const { return m_metricsF.horizontalAdvance(text); }
+    qreal maxCharWidth() const { return m_metricsF.maxWidth(); }
+
+    // Change of width when two characters are drawn together: kerning, ligatures
+    qreal jointWidth(QChar left, QChar right) const
+    {
+        return segmentWidth(QString(left) + right) - segmentWidth(QString(left)) - segmentWidth(QString(right));
+    }
+
+    bool fits(const QString& text) const { return exactWidth(text) <= m_widthLimit; }
+
+    template<typename Estimate>
+    bool mayFit(const Estimate& estimate) const { return estimate.lowerBound() <= m_widthLimit; }
+
+private:
+    QString m_fontKey;
+    QFontMetrics m_metrics;
+    QFontMetricsF m_metricsF;
+    int m_widthLimit;
+};
+
+// Width of concatenated segments: sum of their widths, corrected at every joint by the pair of
+// characters meeting there. So it differs from the real width by rounding only, unless a joint
+// has a surrogate pair, which can't be measured this way; such joints widen the uncertainty.
+class WidthEstimate
+{
+public:
+    explicit WidthEstimate(const CandidateMeasurer& measurer)
+        : m_measurer(measurer)
+    { }
+
+    void append(const QString& segment) { append(segment, m_measurer.segmentWidth(segment)); }
+
+    void append(const QString& segment, qreal width)
+    {
+        if (segment.isEmpty())
+            return;
+
+        if (m_hasText) {
+            const auto first = segment.front();
+
+            if (m_last.isSurrogate() || first.isSurrogate()) {
+                m_uncertainty += m_measurer.maxCharWidth();
+            } else {
+                m_width += m_measurer.jointWidth(m_last, first);
+            }
+        }
+
+        m_width += width;
+        m_last = segment.back();
+        m_hasText = true;
+    }
+
+    qreal lowerBound() const { return m_width - m_uncertainty; }
+
+private:
+    const CandidateMeasurer& m_measurer;
+    qreal m_width {};
+    qreal m_uncertainty {1}; // Real width is rounded
+    QChar m_last;
+    bool m_hasText {};
+};
+
+QString elidePath(const PathEliderDecomposition& decomposition, const CandidateMeasurer& measurer)
+{
+    static const QString ellipsis = QStringLiteral("...");
+
+    const auto separator = decomposition.getSeparatorStr();
+    const auto ellipsisWidth = measurer.segmentWidth(ellipsis);
+    const auto separatorWidth = separator.isEmpty() ? 0 : measurer.segmentWidth(separator);
+    const auto nameWidth = measurer.uncachedWidth(decomposition.name);
+
+    std::vector<qreal> subdirWidths;
+    subdirWidths.reserve(decomposition.subdirs.size());
+    for (const auto& x : decomposition.subdirs)
+        subdirWidths.push_back(measurer.segmentWidth(x));
+
+    // Try remove some middle components. Each run of skipped dirs is replaced with one ellipsis,
+    // every kept part is followed by a separator (see PathEliderDecomposition::combine).
+    std::vector<bool> skipDirs(decomposition.subdirs.size());
+    auto mit = make_middle_iterator(skipDirs.begin(), skipDirs.end());
+    while (mit.isValid()) {
+        *mit++ = true;
+
+        WidthEstimate estimate(measurer);
+        estimate.append(decomposition.protocol);
+
+        for (size_t i = 0; i < skipDirs.size(); i++) {
+            if (!skipDirs[i]) {
+                estimate.append(decomposition.subdirs[static_cast<int>(i)], subdirWidths[i]);
+            } else if (i == 0 || !skipDirs[i - 1]) {
+                estimate.append(ellipsis, ellipsisWidth);
+            } else {
+                continue;
+            }
+
+            estimate.append(separator, separatorWidth);
+        }
+
+        estimate.append(decomposition.name, nameWidth);
+
+        if (measurer.mayFit(estimate)) {
+            auto str = decomposition.combine(skipDirs);
+            if (measurer.fits(str))
+                return str;
+        }
+    }
+
+    // Only name
+    WidthEstimate estimate(measurer);
+    QString possibleResult;
+
+    if (decomposition.subdirs.isEmpty() && decomposition.protocol.isEmpty()) {
+        possibleResult = decomposition.name;
+    } else {
+        const QString nameSeparator = decomposition.separator.value_or('/');
+        estimate.append(ellipsis, ellipsisWidth);
+        estimate.append(nameSeparator);
+        possibleResult = ellipsis + nameSeparator + decomposition.name;
+    }
+
+    estimate.append(decomposition.name, nameWidth);
+
+    if (measurer.mayFit(estimate) && measurer.fits(possibleResult))
+        return possibleResult;
+
+    // Shorten name: keep the longest tail of the name which fits after an ellipsis.
+    // Width doesn't grow when the tail gets shorter, so the tail start is searched by bisection.
+    const auto& name = decomposition.name;
+    auto tail = [&name](int start) { return ellipsis + name.mid(start); };
+
+    const auto last = static_cast<int>(name.size()) - 1;
+
+    if (last < 0 || !measurer.fits(tail(last)))
+        return {};
+
+    int low = 0;
+    int high = last;
+
+    while (low < high) {
+        const auto middle = low + (high - low) / 2;
+
+        if (measurer.fits(tail(middle))) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+
+    return tail(low);
+}
+
+} // namespace
+
 struct PathElider::impl_t
 {
     QString sourceText;
@@ -17,7 +235,11 @@ struct PathElider::impl_t
     int widthLimit {};
     QString elidedText;
 
-    std::unique_ptr<QFontMetrics> fontMetrics;
+    bool hasFont {};
+
+    // Depend on sourceText and font only, so they are reused while widthLimit changes
+    std::optional<int> sourceWidth;
+    std::optional<PathEliderDecomposition> decomposition;
 };
 
 void PathElider::registerTypes()
@@ -36,6 +258,47 @@ PathElider::~PathElider()
 }
 
 PathEliderDecomposition PathElider::decomposePath(const QString& path) const
+{
+    return decompose(path);
+}
+
+QStringList PathElider::elideAll(const QStringList& paths, const QFont& font, int widthLimit, QThreadPool* threadPool)
+{
+    static constexpr int ChunkSize = 256;
+
+    const auto count = static_cast<int>(paths.size());
+    QStringList result;
+
+    if (widthLimit == 0) {
+        result.reserve(count);
+        for (int i = 0; i < count; i++)
+            result.append(QString());
+        return result;
+    }
+
+    std::vector<QString> elided(count);
+
+    // Each chunk has own font metrics, segment widths are shared
+    auto processChunk = [&paths, &font, widthLimit, &elided, count](int chunk) {
+        const CandidateMeasurer measurer(font, widthLimit);
+        const int end = std::min(count, (chunk + 1) * ChunkSize);
+
+        for (int i = chunk * ChunkSize; i < end; i++) {
+            const auto& path = paths.at(i);
+            elided[i] = measurer.fits(path) ? path : elidePath(decompose(path), measurer);
+        }
+    };
+
+    runChunked(threadPool, (count + ChunkSize - 1) / ChunkSize, processChunk);
+
+    result.reserve(count);
+    for (auto& x : elided)
+        result.append(std::move(x));
+
+    return result;
+}
+
+PathEliderDecomposition PathElider::decompose(const QString& path)
 {
     constexpr int ProtocolsGroupIdx = 1;
     constexpr int DirsGroupIdx = 2;
@@ -77,6 +340,8 @@ void PathElider::setSourceText(const QString& value)
     if (impl().sourceText == value)
         return;
     impl().sourceText = value;
+    impl().sourceWidth.reset();
+    impl().decomposition.reset();
     emit sourceTextChanged(impl().sourceText);
 
     recalculate();
@@ -92,9 +357,10 @@ void PathElider::setFont(const QFont& value)
     if (impl().font == value)
         return;
     impl().font = value;
+    impl().hasFont = true;
+    impl().sourceWidth.reset();
     emit fontChanged(impl().font);
 
-    impl().fontMetrics = std::make_unique<QFontMetrics>(impl().font);
     recalculate();
 }
 
@@ -124,8 +390,6 @@ void PathElider::setElidedText(const QString& value)
         return;
     impl().elidedText = value;
     emit elidedTextChanged(impl().elidedText);
-
-    recalculate();
 }
 
 QStringList PathElider::separateSubdirs(const QString& path)
@@ -155,62 +419,27 @@ QStringList PathElider::separateSubdirs(const QString& path)
 
 void PathElider::recalculate()
 {
-    if (!impl().fontMetrics ||
+    if (!impl().hasFont ||
         impl().widthLimit == 0)
     {
         setElidedText({});
         return;
     }
 
-    auto width = impl().fontMetrics->horizontalAdvance(impl().sourceText);
-    if (width <= impl().widthLimit) {
-        setElidedText(impl().sourceText);
-        return;
-    }
-
-    auto decomposition = decomposePath(impl().sourceText);
+    const CandidateMeasurer measurer(impl().font, impl().widthLimit);
 
-    // Try remove some middle components
-    std::vector<bool> skipDirs(decomposition.subdirs.size());
-    auto mit = make_middle_iterator(skipDirs.begin(), skipDirs.end());
-    while (mit.isValid()) {
-        *mit++ = true;
-        auto str = decomposition.combine(skipDirs);
+    if (!impl().sourceWidth)
+        impl().sourceWidth = measurer.exactWidth(impl().sourceText);
 
-        width = impl().fontMetrics->horizontalAdvance(str);
-        if (width <= impl().widthLimit) {
-            setElidedText(str);
-            return;
-        }
-    }
-
-    // Only name
-    QString possibleResult;
-    if (decomposition.subdirs.isEmpty() && decomposition.protocol.isEmpty()) {
-        possibleResult = decomposition.name;
-    } else {
-        possibleResult = QStringLiteral("...") + decomposition.separator.value_or('/') + decomposition.name;
-    }
-
-    width = impl().fontMetrics->horizontalAdvance(possibleResult);
-    if (width <= impl().widthLimit) {
-        setElidedText(possibleResult);
+    if (*impl().sourceWidth <= impl().widthLimit) {
+        setElidedText(impl().sourceText);
         return;
     }
 
-    // Shorten name
-    possibleResult = "..." + decomposition.name;
-    while (possibleResult.size() > 3) {
-        width = impl().fontMetrics->horizontalAdvance(possibleResult);
-        if (width <= impl().widthLimit) {
-            setElidedText(possibleResult);
-            return;
-        } else {
-            possibleResult.remove(3, 1);
-        }
-    }
+    if (!impl().decomposition)
+        impl().decomposition = decompose(impl().sourceText);
 
-    setElidedText("");
+    setElidedText(elidePath(*impl().decomposition, measurer));
 }
 
 QString PathEliderDecomposition::combine(std::vector<bool> skipDirs) const
@@ -22,16 +22,30 @@
 #include <QJSValue>
 #include <QTimer>
 #include <QVector>
+#include <QHash>
+#include <QPair>
+#include <QDateTime>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <vector>
 #ifdef UTILS_QT_OS_WIN
 #include <qt_windows.h>
 #endif
 
 #include <UtilsQt/qvariant_traits.h>
 #include <UtilsQt/invoke_method.h>
+#include <UtilsQt/Futures/Utils.h>
 #include <utils-cpp/container_utils.h>
 #include <utils-cpp/safe_integers.h>
 
+#include "../RunChunked.h"
+
 namespace {
     template<size_t N> constexpr size_t length(char const (&)[N]) { return N-1; }
 
@@ -59,6 +73,232 @@ namespace {
             return info.func.strictlyEquals(func) && info.deleteScheduled == deleteScheduled;
         });
     }
+
+    // Bounded LRU cache of compiled (and JIT-optimized) regular expressions
+    class RegexCache
+    {
+    public:
+        static constexpr size_t Capacity = 64;
+
+        QRegularExpression get(const QString& pattern, int options) const
+        {
+            std::lock_guard lock(m_mutex);
+
+            const Key key(pattern, options);
+            const auto it = m_index.find(key);
+
+            if (it != m_index.end()) {
+                m_lru.splice(m_lru.begin(), m_lru, it.value());
+                return m_lru.front().second;
+            }
+
+            QRegularExpression regex(pattern, QRegularExpression::PatternOptions(options));
+            regex.optimize();
+
+            m_lru.emplace_front(key, regex);
+            m_index.insert(key, m_lru.begin());
+
+            if (m_lru.size() > Capacity) {
+                m_index.remove(m_lru.back().first);
+                m_lru.pop_back();
+            }
+
+            return regex;
+        }
+
+    private:
+        using Key = QPair<QString, int>;
+        using Entry = std::pair<Key, QRegularExpression>;
+
+        mutable std::mutex m_mutex;
+        mutable std::list<Entry> m_lru;
+        mutable QHash<Key, std::list<Entry>::iterator> m_index;
+    };
+
+    PathDetails analyzePathImpl(const QString& str)
+    {
+        if ((str.size() >= 2 && str[1] == ':')) {
+            return {str, PathDetails::Windows, true};
+
+        } else if (str.startsWith(filePrefixWin)) {
+            return {str.mid(filePrefixWinLen), PathDetails::Windows, true};
+
+        } else if (str.startsWith("/")) {
+            return {str, PathDetails::NonWindows, true};
+
+        } else if (str.startsWith(filePrefix)) {
+            return {str.mid(filePrefixLen), PathDetails::NonWindows, true};
+
+        } else if (str.startsWith(qrcPrefix)) {
+            return {qrcPrefixReplacement + str.mid(qrcPrefixLen), PathDetails::Qrc, true};
+
+        } else if (str.startsWith(qrcPrefixReplacement)) {
+            return {str, PathDetails::Qrc, true};
+        }
+
+        return {str, PathDetails::Unknown, false};
+    }
+
+    QString realFileNameImpl(const QString& str)
+    {
+        const auto normStr = analyzePathImpl(str).path;
+        QFileInfo fileInfo(normStr);
+        return fileInfo.isSymLink() ? fileInfo.symLinkTarget() : normStr; // Add normalizePath to symLink?
+    }
+
+    // Bounded LRU cache of image metadata. Entry is valid while file's modification time and size match.
+    class ImageMetadataCache
+    {
+    public:
+        static constexpr size_t Capacity = 2048;
+
+        ImageMetadata get(const QString& path) const
+        {
+            const QFileInfo fileInfo(path);
+            const Stamp stamp {fileInfo.lastModified().toMSecsSinceEpoch(), fileInfo.size()};
+
+            {
+                std::lock_guard lock(m_mutex);
+                const auto it = m_index.find(path);
+
+                if (it != m_index.end()) {
+                    if (it.value()->stamp == stamp) {
+                        m_lru.splice(m_lru.begin(), m_lru, it.value());
+                        return m_lru.front().metadata;
+                    }
+
+                    m_lru.erase(it.value());
+                    m_index.erase(it);
+                }
+            }
+
+            // Read outside of lock, it's the slow part
+            const auto metadata = read(path);
+
+            std::lock_guard lock(m_mutex);
+
+            if (!m_index.contains(path)) {
+                m_lru.push_front({path, stamp, metadata});
+                m_index.insert(path, m_lru.begin());
+
+                if (m_lru.size() > Capacity) {
+                    m_index.remove(m_lru.back().path);
+                    m_lru.pop_back();
+                }
+            }
+
+            return metadata;
+        }
+
+    private:
+        using Stamp = std::pair<qint64, qint64>; // Modification time, file size
+
+        struct Entry
+        {
+            QString path;
+            Stamp stamp;
+            ImageMetadata metadata;
+        };
+
+        static ImageMetadata read(const QString& path)
+        {
+            QImageReader reader(path);
+            ImageMetadata result;
+
+            // Only header is parsed here, no decoding
+            result.format = reader.format();
+
+            if (result.isValid()) {
+                result.size = reader.size();
+                result.transformation = reader.transformation();
+            }
+
+            return result;
+        }
+
+        mutable std::mutex m_mutex;
+        mutable std::list<Entry> m_lru;
+        mutable QHash<QString, std::list<Entry>::iterator> m_index;
+    };
+
+    QString extractMatch(const QRegularExpression& regex, const QString& source)
+    {
+        const auto match = regex.match(source);
+        return match.hasMatch() ? match.captured() : "";
+    }
+
+    constexpr int MinParallelChunk = 256; // Sources per thread
+
+    // Appends found files to `result`. Returns false if canceled.
+    bool collectFiles(const QString& dirPath, const QStringList& nameFilters, bool recursive,
+                      QStringList& result, const std::function<bool()>& isCanceled = {})
+    {
+        QDir::Filters filters = QDir::Files | QDir::NoSymLinks | QDir::Readable | QDir::NoDotAndDotDot;
+
+        QDirIterator it(dirPath,
+                        nameFilters,
+                        filters,
+                        recursive ? QDirIterator::Subdirectories : QDirIterator::NoIteratorFlags);
+
+        while (it.hasNext()) {
+            if (isCanceled && isCanceled())
+                return false;
+
+            it.next();
+            result.append(it.filePath());
+        }
+
+        return true;
+    }
+
+    // Subdirectories which QDirIterator::Subdirectories would enter (no hidden, no symlinks)
+    QStringList listSubdirs(const QString& dirPath)
+    {
+        QStringList result;
+        QDirIterator it(dirPath, QDir::Dirs | QDir::NoSymLinks | QDir::NoDotAndDotDot);
+
+        while (it.hasNext()) {
+            it.next();
+            result.append(it.filePath());
+        }
+
+        return result;
+    }
+
+    void finishListing(UtilsQt::Promise<QStringList>& promise, QStringList& result, bool sorted)
+    {
+        if (promise.isCanceled()) {
+            promise.cancel();
+            return;
+        }
+
+        if (sorted)
+            result.sort(Qt::CaseInsensitive);
+
+        promise.finish(std::move(result));
+    }
+
+    struct ParallelListing
+    {
+        UtilsQt::Promise<QStringList> promise;
+        QStringList nameFilters;
+        bool sorted {};
+
+        std::mutex mutex;
+        QStringList result;
+        std::atomic<int> remaining {};
+
+        void append(const QStringList& files)
+        {
+            {
+                std::lock_guard lock(mutex);
+                result.append(files);
+            }
+
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                finishListing(promise, result, sorted);
+        }
+    };
 }
 
 
@@ -72,6 +312,8 @@ struct QmlUtils::impl_t
     QJSEngine* jsEngine { nullptr };
     QVector<PendingCallInfo> pendingCalls;
     GUIDAnonymizer machineUniqueIdAnonymizer;
+    RegexCache regexCache;
+    std::shared_ptr<ImageMetadataCache> imageMetadataCache { std::make_shared<ImageMetadataCache>() }; // Shared with prefetch tasks
 };
 
 
@@ -163,26 +405,7 @@ void QmlUtils::setMachineUniqueIdAnonymizer(const GUIDAnonymizer& anonymizer)
 
 PathDetails QmlUtils::analyzePath(const QString& str) const
 {
-    if ((str.size() >= 2 && str[1] == ':')) {
-        return {str, PathDetails::Windows, true};
-
-    } else if (str.startsWith(filePrefixWin)) {
-        return {str.mid(filePrefixWinLen), PathDetails::Windows, true};
-
-    } else if (str.startsWith("/")) {
-        return {str, PathDetails::NonWindows, true};
-
-    } else if (str.startsWith(filePrefix)) {
-        return {str.mid(filePrefixLen), PathDetails::NonWindows, true};
-
-    } else if (str.startsWith(qrcPrefix)) {
-        return {qrcPrefixReplacement + str.mid(qrcPrefixLen), PathDetails::Qrc, true};
-
-    } else if (str.startsWith(qrcPrefixReplacement)) {
-        return {str, PathDetails::Qrc, true};
-    }
-
-    return {str, PathDetails::Unknown, false};
+    return analyzePathImpl(str);
 }
 
 QString QmlUtils::toUrl(const QString& str) const
@@ -212,12 +435,72 @@ QString QmlUtils::toUrl(const QString& str) const
 
 bool QmlUtils::isImage(const QString& fileName) const
 {
-    return !QImageReader::imageFormat(realFileName(fileName)).isEmpty();
+    return imageMetadata(fileName).isValid();
 }
 
 QSize QmlUtils::imageSize(const QString& fileName) const
 {
-    return QImageReader(realFileName(fileName)).size();
+    return imageMetadata(fileName).size;
+}
+
+ImageMetadata QmlUtils::imageMetadata(const QString& fileName) const
+{
+    return impl().imageMetadataCache->get(realFileNameImpl(fileName));
+}
+
+QFuture<int> QmlUtils::prefetchImageMetadata(const QStringList& fileNames) const
+{
+    UtilsQt::Promise<int> promise(true);
+
+    // Tasks hold the cache, not `this`: they can outlive QmlUtils::instance() at exit
+    QThreadPool::globalInstance()->start([cache = impl().imageMetadataCache, promise, fileNames]() mutable {
+        int images = 0;
+
+        for (const auto& fileName : fileNames) {
+            if (promise.isCanceled()) {
+                promise.cancel();
+                return;
+            }
+
+            if (cache->get(realFileNameImpl(fileName)).isValid())
+                images++;
+        }
+
+        promise.finish(images);
+    });
+
+    return promise.future();
+}
+
+QFuture<int> QmlUtils::prefetchImageMetadata(const QString& path, const QStringList& nameFilters, bool recursive) const
+{
+    const auto dirPath = QDir(normalizePath(path)).absolutePath();
+    UtilsQt::Promise<int> promise(true);
+
+    QThreadPool::globalInstance()->start([cache = impl().imageMetadataCache, promise, dirPath, nameFilters, recursive]() mutable {
+        const auto isCanceled = [&promise](){ return promise.isCanceled(); };
+        QStringList files;
+        int images = 0;
+
+        if (collectFiles(dirPath, nameFilters, recursive, files, isCanceled)) {
+            for (const auto& file : std::as_const(files)) {
+                if (isCanceled())
+                    break;
+
+                if (cache->get(realFileNameImpl(file)).isValid())
+                    images++;
+            }
+        }
+
+        if (isCanceled()) {
+            promise.cancel();
+            return;
+        }
+
+        promise.finish(images);
+    });
+
+    return promise.future();
 }
 
 QSize QmlUtils::fitSize(const QSize& sourceSize, const QSize& limits) const
@@ -296,9 +579,7 @@ int QmlUtils::bound(int min, int value, int max) const
 
 QString QmlUtils::realFileName(const QString& str) const
 {
-    const auto normStr = normalizePath(str);
-    QFileInfo fileInfo(normStr);
-    return fileInfo.isSymLink() ? fileInfo.symLinkTarget() : normStr; // Add normalizePath to symLink?
+    return realFileNameImpl(str);
 }
 
 QString QmlUtils::realFileNameUrl(const QString& str) const
@@ -349,16 +630,14 @@ bool QmlUtils::compare(const QVariant& value1, const QVariant& value2) const
     return (value1 == value2);
 }
 
-QString QmlUtils::extractByRegex(const QString& source, const QString& pattern) const
+QString QmlUtils::extractByRegex(const QString& source, const QString& pattern, int options) const
 {
-    QRegularExpression regex(pattern);
-    auto match = regex.match(source);
-    return match.hasMatch() ? match.captured() : "";
+    return extractMatch(impl().regexCache.get(pattern, options), source);
 }
 
-QStringList QmlUtils::extractByRegexGroups(const QString& source, const QString& pattern, const QList<int>& groups) const
+QStringList QmlUtils::extractByRegexGroups(const QString& source, const QString& pattern, const QList<int>& groups, int options) const
 {
-    QRegularExpression regex(pattern);
+    const auto regex = impl().regexCache.get(pattern, options);
     auto match = regex.match(source);
     if (!match.hasMatch()) return {};
 
@@ -371,6 +650,37 @@ QStringList QmlUtils::extractByRegexGroups(const QString& source, const QString&
     return result;
 }
 
+QStringList QmlUtils::extractByRegexBatch(const QStringList& sources, const QString& pattern, int options, bool parallel) const
+{
+    const auto regex = impl().regexCache.get(pattern, options);
+    const int count = sources.size();
+    std::vector<QString> values(count);
+
+    auto process = [&regex, &sources, &values](int begin, int end) {
+        for (int i = begin; i < end; i++)
+            values[i] = extractMatch(regex, sources.at(i));
+    };
+
+    const int threads = parallel ? std::min(QThread::idealThreadCount(), count / MinParallelChunk) : 1;
+
+    if (threads > 1) {
+        const int chunk = (count + threads - 1) / threads;
+        runChunked(QThreadPool::globalInstance(), threads, [&process, count, chunk](int i) {
+            process(i * chunk, std::min(count, (i + 1) * chunk));
+        });
+    } else {
+        process(0, count);
+    }
+
+    QStringList result;
+    result.reserve(count);
+
+    for (auto& x : values)
+        result.append(std::move(x));
+
+    return result;
+}
+
 QString QmlUtils::toHex(int value, bool upperCase, int width) const
 {
     auto result = QStringLiteral("%1").arg(value, width, 16, QChar('0'));
@@ -410,23 +720,56 @@ bool QmlUtils::localFileExists(const QString& fileName) const
 QStringList QmlUtils::listFiles(const QString& path, const QStringList& nameFilters, bool recursive) const
 {
     QDir dir(normalizePath(path));
-    QDir::Filters filters = QDir::Files | QDir::NoSymLinks | QDir::Readable | QDir::NoDotAndDotDot;
-
-    QDirIterator it(dir.absolutePath(),
-                    nameFilters,
-                    filters,
-                    recursive ? QDirIterator::Subdirectories : QDirIterator::NoIteratorFlags);
 
     QStringList result;
-    while (it.hasNext()) {
-        it.next();
-        result.append(it.filePath());
-    }
+    collectFiles(dir.absolutePath(), nameFilters, recursive, result);
 
     result.sort(Qt::CaseInsensitive);
     return result;
 }
 
+QFuture<QStringList> QmlUtils::listFilesAsync(const QString& path, const QStringList& nameFilters, const ListFilesOptions& options) const
+{
+    const auto dirPath = QDir(normalizePath(path)).absolutePath();
+    UtilsQt::Promise<QStringList> promise(true);
+    auto pool = QThreadPool::globalInstance();
+
+    if (!options.recursive || !options.parallel) {
+        pool->start([promise, dirPath, nameFilters, options]() mutable {
+            QStringList result;
+            collectFiles(dirPath, nameFilters, options.recursive, result, [&promise](){ return promise.isCanceled(); });
+            finishListing(promise, result, options.sorted);
+        });
+
+        return promise.future();
+    }
+
+    // Root files and each top-level subdirectory are walked by separate tasks
+    pool->start([promise, dirPath, nameFilters, options, pool]() {
+        auto listing = std::make_shared<ParallelListing>();
+        listing->promise = promise;
+        listing->nameFilters = nameFilters;
+        listing->sorted = options.sorted;
+
+        const auto subdirs = listSubdirs(dirPath);
+        listing->remaining = subdirs.size() + 1;
+
+        for (const auto& subdir : subdirs) {
+            pool->start([listing, subdir]() {
+                QStringList files;
+                collectFiles(subdir, listing->nameFilters, true, files, [&listing](){ return listing->promise.isCanceled(); });
+                listing->append(files);
+            });
+        }
+
+        QStringList files;
+        collectFiles(dirPath, nameFilters, false, files, [&listing](){ return listing->promise.isCanceled(); });
+        listing->append(files);
+    });
+
+    return promise.future();
+}
+
 void QmlUtils::showWindow(QObject* win)
 {
     auto window = qobject_cast<QQuickWindow*>(win);
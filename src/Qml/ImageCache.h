@@ -0,0 +1,109 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/utils-qt
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <QString>
+#include <QSize>
+#include <QImage>
+#include <QHash>
+#include <QPair>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <optional>
+
+// Byte-bounded LRU cache of rendered images, keyed by name (path, id) and size.
+// Entry is valid while source file's modification time and size match.
+class ImageCache
+{
+public:
+    explicit ImageCache(qint64 limit): m_limit(limit) { }
+
+    std::optional<QImage> get(const QString& name, const QSize& size, qint64 modified, qint64 fileSize)
+    {
+        std::lock_guard lock(m_mutex);
+
+        const auto it = m_index.find(makeKey(name, size));
+        if (it == m_index.end())
+            return {};
+
+        if (it.value()->modified != modified || it.value()->fileSize != fileSize) {
+            removeEntry(it.value());
+            return {};
+        }
+
+        m_lru.splice(m_lru.begin(), m_lru, it.value());
+        return m_lru.front().image;
+    }
+
+    void insert(const QString& name, const QSize& size, qint64 modified, qint64 fileSize, const QImage& image)
+    {
+        std::lock_guard lock(m_mutex);
+
+        const auto key = makeKey(name, size);
+        const auto it = m_index.find(key);
+        if (it != m_index.end())
+            removeEntry(it.value());
+
+        const auto bytes = static_cast<qint64>(image.sizeInBytes());
+        if (bytes > m_limit)
+            return;
+
+        m_lru.push_front({key, modified, fileSize, image});
+        m_index.insert(key, m_lru.begin());
+        m_bytes += bytes;
+
+        shrink();
+    }
+
+    void setLimit(qint64 bytes)
+    {
+        std::lock_guard lock(m_mutex);
+        m_limit = bytes;
+        shrink();
+    }
+
+    void clear()
+    {
+        std::lock_guard lock(m_mutex);
+        m_lru.clear();
+        m_index.clear();
+        m_bytes = 0;
+    }
+
+private:
+    using Key = QPair<QString, quint64>;
+
+    struct Entry
+    {
+        Key key;
+        qint64 modified {};
+        qint64 fileSize {};
+        QImage image;
+    };
+
+    static Key makeKey(const QString& name, const QSize& size)
+    {
+        return {name, (static_cast<quint64>(static_cast<quint32>(size.width())) << 32) | static_cast<quint32>(size.height())};
+    }
+
+    void removeEntry(std::list<Entry>::iterator it)
+    {
+        m_bytes -= static_cast<qint64>(it->image.sizeInBytes());
+        m_index.remove(it->key);
+        m_lru.erase(it);
+    }
+
+    void shrink()
+    {
+        while (m_bytes > m_limit && !m_lru.empty())
+            removeEntry(std::prev(m_lru.end()));
+    }
+
+    std::mutex m_mutex;
+    std::list<Entry> m_lru;
+    QHash<Key, std::list<Entry>::iterator> m_index;
+    qint64 m_bytes {};
+    qint64 m_limit {};
+};
@@ -5,14 +5,41 @@
 #include <UtilsQt/Qml/ImageProviderBorderImage.h>
 
 #include <UtilsQt/Qml-Cpp/QmlUtils.h>
+#include "ImageCache.h"
 #include <QString>
 #include <QImage>
 #include <QQmlEngine>
-#include <QPainter>
+#include <QFileInfo>
+#include <QDebug>
+#include <QDateTime>
+#include <QHash>
+#include <QSet>
+#include <QRect>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <vector>
 
-static QMap<QString, QString> parseParams(const QString &id)
+namespace {
+
+enum class Orientation { Unknown, Vertical, Horizontal };
+enum class FillMode { Unknown, Stretch, Tile };
+
+struct BorderParams
+{
+    QString path;
+    Orientation orientation { Orientation::Vertical };
+    FillMode fill { FillMode::Stretch };
+    int top {};
+    int bottom {};
+    int left {};
+    int right {};
+};
+
+BorderParams parseParams(const QString &id)
 {
-    QMap<QString, QString> params;
+    BorderParams params;
 
     static const QSet<QString> allowedKeys = {"path", "top", "bottom", "left", "right", "width", "height", "orientation", "fill"};
 
@@ -23,151 +50,368 @@ static QMap<QString, QString> parseParams(const QString &id)
             QString key = pair.left(eq).trimmed();
             QString value = pair.mid(eq + 1).trimmed();
             assert(allowedKeys.contains(key) && "Unexpected parameter");
-            params.insert(key, value);
+
+            if (key == "path") {
+                params.path = value;
+            } else if (key == "orientation") {
+                value = value.toLower();
+                params.orientation = value == "vertical"   ? Orientation::Vertical :
+                                     value == "horizontal" ? Orientation::Horizontal :
+                                                             Orientation::Unknown;
+                assert(params.orientation != Orientation::Unknown && "Unsupported orientation");
+            } else if (key == "fill") {
+                value = value.toLower();
+                params.fill = value == "stretch" ? FillMode::Stretch :
+                              value == "tile"    ? FillMode::Tile :
+                                                   FillMode::Unknown;
+                assert(params.fill != FillMode::Unknown && "Unsupported fill mode");
+            } else if (key == "top") {
+                params.top = value.toInt();
+            } else if (key == "bottom") {
+                params.bottom = value.toInt();
+            } else if (key == "left") {
+                params.left = value.toInt();
+            } else if (key == "right") {
+                params.right = value.toInt();
+            }
         }
     }
     return params;
 }
 
-void ImageProviderBorderImage::registerTypes(QQmlEngine& engine)
+constexpr int MaxCachedParams = 256;
+constexpr int MaxCachedSources = 32;
+
+// Parsed ids and decoded sources. Both are small, so they're just dropped on overflow.
+class SourceCache
 {
-    engine.addImageProvider("UtilsQt-BorderImage", new ImageProviderBorderImage());
+public:
+    BorderParams params(const QString& id)
+    {
+        std::lock_guard lock(m_mutex);
+
+        const auto it = m_params.constFind(id);
+        if (it != m_params.constEnd())
+            return it.value();
+
+        if (m_params.size() >= MaxCachedParams)
+            m_params.clear();
+
+        return m_params.insert(id, parseParams(id)).value();
+    }
+
+    // Returns source scaled to the size returned by `scaledSizeFunc(originalSize)`, in ARGB32 format. Null if failed to load.
+    QImage scaledSource(const QString& path, qint64 modified, qint64 fileSize, const std::function<QSize(const QSize&)>& scaledSizeFunc)
+    {
+        QImage original;
+        bool isLoaded = false;
+
+        {
+            std::lock_guard lock(m_mutex);
+            const auto it = m_sources.constFind(path);
+
+            if (it != m_sources.cend() && it->modified == modified && it->fileSize == fileSize) {
+                if (it->original.isNull())
+                    return {};
+
+                if (!it->scaled.isNull() && it->scaledSize == scaledSizeFunc(it->original.size()))
+                    return it->scaled;
+
+                original = it->original;
+                isLoaded = true;
+            }
+        }
+
+        // Decoding and scaling are done without lock, so loaders of other images aren't blocked.
+        // Concurrent loaders of the same image may do it twice, then the last result is kept.
+        if (!isLoaded)
+            original = QImage(path);
+
+        Source source {modified, fileSize, original, {}, {}};
+
+        if (!original.isNull()) {
+            source.scaledSize = scaledSizeFunc(original.size());
+            source.scaled = original.scaled(source.scaledSize, Qt::KeepAspectRatio, Qt::SmoothTransformation)
+                                    .convertToFormat(QImage::Format_ARGB32);
+        }
+
+        std::lock_guard lock(m_mutex);
+
+        if (m_sources.size() >= MaxCachedSources && !m_sources.contains(path))
+            m_sources.clear();
+
+        m_sources.insert(path, source);
+        return source.scaled;
+    }
+
+    void clear()
+    {
+        std::lock_guard lock(m_mutex);
+        m_params.clear();
+        m_sources.clear();
+    }
+
+private:
+    struct Source
+    {
+        qint64 modified {};
+        qint64 fileSize {};
+        QImage original;
+        QSize scaledSize;  // Last one. Usually only one dimension changes during resizing,
+        QImage scaled;     // so the scaled source stays the same.
+    };
+
+    std::mutex m_mutex;
+    QHash<QString, BorderParams> m_params;
+    QHash<QString, Source> m_sources;
+};
+
+SourceCache& sourceCache()
+{
+    static SourceCache cache;
+    return cache;
 }
 
-QImage ImageProviderBorderImage::requestImage(const QString& id, QSize* size, const QSize& requestedSize)
+ImageCache& outputCache()
 {
-    assert(size);
+    static ImageCache cache(ImageProviderBorderImage::DefaultCacheLimit);
+    return cache;
+}
 
-    if (requestedSize.width() <= 0 || requestedSize.height() <= 0) {
-        QImage stub(10, 10, QImage::Format_ARGB32);
-        stub.fill(QColor::fromRgbF(0.5, 0.5, 0.5));
-        *size = stub.size();
-        return stub;
+// --- Compositing. Both images are ARGB32. Rectangles may exceed image bounds, then they're clipped
+// like with QPainter: target to the destination image, source to the source image. ---
+inline QRgb* pixels(QImage& image, int x, int y)
+{
+    return reinterpret_cast<QRgb*>(image.scanLine(y)) + x;
+}
+
+inline const QRgb* pixels(const QImage& image, int x, int y)
+{
+    return reinterpret_cast<const QRgb*>(image.constScanLine(y)) + x;
+}
+
+// Maps target pixel center to source pixel (nearest neighbour, like QPainter without smoothing)
+inline int mapNearest(int i, int targetLength, int sourceLength)
+{
+    return std::min(sourceLength - 1, static_cast<int>((2 * qint64(i) + 1) * sourceLength / (2 * qint64(targetLength))));
+}
+
+// Also copies regions of the same size, then source pixels are mapped 1:1
+void stretchRegion(QImage& dst, const QRect& target, const QImage& src, const QRect& source)
+{
+    const QRect visible = target & dst.rect();
+    if (visible.isEmpty())
+        return;
+
+    // Source column of each visible column, -1 if it's outside of the source image
+    const int width = visible.width();
+    std::vector<int> columns(width);
+    bool allColumns = true;
+    bool contiguous = true;
+
+    for (int x = 0; x < width; x++) {
+        const int sourceX = source.x() + mapNearest(visible.x() + x - target.x(), target.width(), source.width());
+        const bool inBounds = (sourceX >= 0 && sourceX < src.width());
+
+        columns[x] = inBounds ? sourceX : -1;
+        allColumns = allColumns && inBounds;
+        contiguous = contiguous && sourceX == columns[0] + x;
     }
 
-    // Parse the id string for parameters.
-    QMap<QString, QString> params = parseParams(id);
+    const auto rowBytes = static_cast<size_t>(width) * sizeof(QRgb);
+    const QRgb* prevRow {};
+    int prevSourceY = -1;
 
-    // Mandatory parameters
-    const QString path = params.value("path");
-    const int finalWidth = requestedSize.width();
-    const int finalHeight = requestedSize.height();
-    const QString orientation = params.value("orientation", "vertical").toLower();
-    const QString fillMode = params.value("fill", "stretch").toLower();
+    for (int y = visible.top(); y <= visible.bottom(); y++) {
+        const int sourceY = source.y() + mapNearest(y - target.y(), target.height(), source.height());
+        if (sourceY < 0 || sourceY >= src.height())
+            continue;
 
-    // Optional border parameters (defaulting to 0 if missing)
-    const int top = params.contains("top") ? params.value("top").toInt() : 0;
-    const int bottom = params.contains("bottom") ? params.value("bottom").toInt() : 0;
-    const int left = params.contains("left") ? params.value("left").toInt() : 0;
-    const int right = params.contains("right") ? params.value("right").toInt() : 0;
+        QRgb* row = pixels(dst, visible.x(), y);
 
-    // Return final image size as requested.
-    *size = QSize(finalWidth, finalHeight);
+        if (allColumns && sourceY == prevSourceY) {
+            std::memcpy(row, prevRow, rowBytes); // Upscaled vertically, repeat composed row
+        } else if (allColumns && contiguous) {
+            std::memcpy(row, pixels(src, columns[0], sourceY), rowBytes);
+        } else {
+            const QRgb* sourceRow = pixels(src, 0, sourceY);
+            for (int x = 0; x < width; x++)
+                if (columns[x] >= 0)
+                    row[x] = sourceRow[columns[x]];
+        }
 
-    // Load the source image (using a normalized path, if available).
-    const QString normalizedPath = QmlUtils::instance().normalizePath(path);
-    QImage source(normalizedPath);
-    if (source.isNull()) {
-        qWarning() << "Failed to load source image:" << normalizedPath;
-        return QImage(finalWidth, finalHeight, QImage::Format_ARGB32);
+        prevRow = row;
+        prevSourceY = sourceY;
     }
+}
 
-    const int origWidth = source.width();
-    const int origHeight = source.height();
+// Tiles start at the target's top-left corner. Parts of the tile outside of the source image are skipped.
+void tileRegion(QImage& dst, const QRect& target, const QImage& src, const QRect& source)
+{
+    const QRect visible = target & dst.rect();
+    if (visible.isEmpty())
+        return;
 
-    // Compute the scale factor based on the orientation.
-    double scaleFactor = 1.0;
-    if (orientation == "vertical") {
-        scaleFactor = double(finalWidth) / double(origWidth);
-    } else if (orientation == "horizontal") {
-        scaleFactor = double(finalHeight) / double(origHeight);
-    } else {
-        assert(false && "Unsupported orientation");
+    // Columns of the tile within the source image
+    const int firstColumn = std::max(0, -source.x());
+    const int lastColumn = std::min(source.width(), src.width() - source.x());
+    if (firstColumn >= lastColumn)
+        return;
+
+    const bool fullRows = (firstColumn == 0 && lastColumn == source.width());
+    const auto rowBytes = static_cast<size_t>(visible.width()) * sizeof(QRgb);
+    const int firstTileX = target.x() + (visible.x() - target.x()) / source.width() * source.width();
+
+    for (int y = visible.top(); y <= visible.bottom(); y++) {
+        const int sourceY = source.y() + (y - target.y()) % source.height();
+        if (sourceY < 0 || sourceY >= src.height())
+            continue;
+
+        // Rows repeat with the tile period, so copy the row composed one period above
+        if (fullRows && y - source.height() >= visible.top()) {
+            std::memcpy(pixels(dst, visible.x(), y), pixels(dst, visible.x(), y - source.height()), rowBytes);
+            continue;
+        }
+
+        QRgb* row = pixels(dst, 0, y);
+        const QRgb* sourceRow = pixels(src, 0, sourceY);
+
+        for (int tileX = firstTileX; tileX <= visible.right(); tileX += source.width()) {
+            const int begin = std::max(tileX + firstColumn, visible.x());
+            const int end = std::min(tileX + lastColumn, visible.right() + 1);
+
+            if (begin < end)
+                std::memcpy(row + begin, sourceRow + source.x() + (begin - tileX), static_cast<size_t>(end - begin) * sizeof(QRgb));
+        }
     }
+}
+// --- ---
 
-    // Scale the entire source image proportionally.
-    const int scaledWidth = qRound(origWidth * scaleFactor);
-    const int scaledHeight = qRound(origHeight * scaleFactor);
-    QImage scaledImage = source.scaled(scaledWidth, scaledHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+QImage render(const BorderParams& params, const QImage& scaledImage, const QSize& finalSize, double scaleFactor)
+{
+    const int finalWidth = finalSize.width();
+    const int finalHeight = finalSize.height();
 
     // Scale the border parameters accordingly.
-    const int topScaled = qRound(top * scaleFactor);
-    const int bottomScaled = qRound(bottom * scaleFactor);
-    const int leftScaled = qRound(left * scaleFactor);
-    const int rightScaled = qRound(right * scaleFactor);
+    const int topScaled = qRound(params.top * scaleFactor);
+    const int bottomScaled = qRound(params.bottom * scaleFactor);
+    const int leftScaled = qRound(params.left * scaleFactor);
+    const int rightScaled = qRound(params.right * scaleFactor);
 
     // Create the final image of exactly the requested size.
     QImage finalImage(finalWidth, finalHeight, QImage::Format_ARGB32);
     finalImage.fill(Qt::transparent);
-    QPainter painter(&finalImage);
 
     // Dimensions of the scaled image.
     const int srcW = scaledImage.width();
     const int srcH = scaledImage.height();
 
-    // --- Define source rectangles from the scaled image ---
-    // Corners:
-    QRect srcTopLeft(0, 0, leftScaled, topScaled);
-    QRect srcTopRight(srcW - rightScaled, 0, rightScaled, topScaled);
-    QRect srcBottomLeft(0, srcH - bottomScaled, leftScaled, bottomScaled);
-    QRect srcBottomRight(srcW - rightScaled, srcH - bottomScaled, rightScaled, bottomScaled);
-    // Edges:
-    QRect srcTopEdge(leftScaled, 0, srcW - leftScaled - rightScaled, topScaled);
-    QRect srcBottomEdge(leftScaled, srcH - bottomScaled, srcW - leftScaled - rightScaled, bottomScaled);
-    QRect srcLeftEdge(0, topScaled, leftScaled, srcH - topScaled - bottomScaled);
-    QRect srcRightEdge(srcW - rightScaled, topScaled, rightScaled, srcH - topScaled - bottomScaled);
-    // Center:
-    QRect srcCenter(leftScaled, topScaled, srcW - leftScaled - rightScaled, srcH - topScaled - bottomScaled);
-
-    // --- Define target rectangles in the final image ---
-    // Corners: (drawn at their native scaled sizes)
-    QRect tgtTopLeft(0, 0, leftScaled, topScaled);
-    QRect tgtTopRight(finalWidth - rightScaled, 0, rightScaled, topScaled);
-    QRect tgtBottomLeft(0, finalHeight - bottomScaled, leftScaled, bottomScaled);
-    QRect tgtBottomRight(finalWidth - rightScaled, finalHeight - bottomScaled, rightScaled, bottomScaled);
-    // Edges:
-    QRect tgtTopEdge(leftScaled, 0, finalWidth - leftScaled - rightScaled, topScaled);
-    QRect tgtBottomEdge(leftScaled, finalHeight - bottomScaled, finalWidth - leftScaled - rightScaled, bottomScaled);
-    QRect tgtLeftEdge(0, topScaled, leftScaled, finalHeight - topScaled - bottomScaled);
-    QRect tgtRightEdge(finalWidth - rightScaled, topScaled, rightScaled, finalHeight - topScaled - bottomScaled);
-    // Center:
-    QRect tgtCenter(leftScaled, topScaled, finalWidth - leftScaled - rightScaled, finalHeight - topScaled - bottomScaled);
-
-    // Lambda for drawing a region with the chosen fill mode (used for edges and center).
-    auto drawRegion = [&](const QRect& target, const QRect& src) {
-        if (!src.isEmpty() && !target.isEmpty()) {
-            if (fillMode == "tile") {
-                QPixmap tilePixmap = QPixmap::fromImage(scaledImage.copy(src));
-                painter.drawTiledPixmap(target, tilePixmap);
-            } else if (fillMode == "stretch") {
-                painter.drawImage(target, scaledImage, src);
-            } else {
-                assert(false && "Unsupported fill mode");
-            }
+    // Draws a non-empty region, parts outside of the images are clipped
+    auto drawRegion = [&](const QRect& target, const QRect& src, bool isCorner) {
+        if (src.isEmpty() || target.isEmpty())
+            return;
+
+        if (isCorner || target.size() == src.size() || params.fill == FillMode::Stretch) {
+            stretchRegion(finalImage, target, scaledImage, src);
+        } else if (params.fill == FillMode::Tile) {
+            tileRegion(finalImage, target, scaledImage, src);
         }
     };
 
-    // --- Draw each region with proper scaling ---
     // Corners: drawn as-is.
-    if (!srcTopLeft.isEmpty() && !tgtTopLeft.isEmpty())
-        painter.drawImage(tgtTopLeft, scaledImage, srcTopLeft);
-    if (!srcTopRight.isEmpty() && !tgtTopRight.isEmpty())
-        painter.drawImage(tgtTopRight, scaledImage, srcTopRight);
-    if (!srcBottomLeft.isEmpty() && !tgtBottomLeft.isEmpty())
-        painter.drawImage(tgtBottomLeft, scaledImage, srcBottomLeft);
-    if (!srcBottomRight.isEmpty() && !tgtBottomRight.isEmpty())
-        painter.drawImage(tgtBottomRight, scaledImage, srcBottomRight);
+    drawRegion({0, 0, leftScaled, topScaled},
+               {0, 0, leftScaled, topScaled}, true);
+    drawRegion({finalWidth - rightScaled, 0, rightScaled, topScaled},
+               {srcW - rightScaled, 0, rightScaled, topScaled}, true);
+    drawRegion({0, finalHeight - bottomScaled, leftScaled, bottomScaled},
+               {0, srcH - bottomScaled, leftScaled, bottomScaled}, true);
+    drawRegion({finalWidth - rightScaled, finalHeight - bottomScaled, rightScaled, bottomScaled},
+               {srcW - rightScaled, srcH - bottomScaled, rightScaled, bottomScaled}, true);
 
     // Edges: scaled in one dimension.
-    drawRegion(tgtTopEdge, srcTopEdge);
-    drawRegion(tgtBottomEdge, srcBottomEdge);
-    drawRegion(tgtLeftEdge, srcLeftEdge);
-    drawRegion(tgtRightEdge, srcRightEdge);
+    drawRegion({leftScaled, 0, finalWidth - leftScaled - rightScaled, topScaled},
+               {leftScaled, 0, srcW - leftScaled - rightScaled, topScaled}, false);
+    drawRegion({leftScaled, finalHeight - bottomScaled, finalWidth - leftScaled - rightScaled, bottomScaled},
+               {leftScaled, srcH - bottomScaled, srcW - leftScaled - rightScaled, bottomScaled}, false);
+    drawRegion({0, topScaled, leftScaled, finalHeight - topScaled - bottomScaled},
+               {0, topScaled, leftScaled, srcH - topScaled - bottomScaled}, false);
+    drawRegion({finalWidth - rightScaled, topScaled, rightScaled, finalHeight - topScaled - bottomScaled},
+               {srcW - rightScaled, topScaled, rightScaled, srcH - topScaled - bottomScaled}, false);
 
     // Center: scaled in both dimensions.
-    drawRegion(tgtCenter, srcCenter);
-
-    painter.end();
+    drawRegion({leftScaled, topScaled, finalWidth - leftScaled - rightScaled, finalHeight - topScaled - bottomScaled},
+               {leftScaled, topScaled, srcW - leftScaled - rightScaled, srcH - topScaled - bottomScaled}, false);
 
     return finalImage;
 }
+
+} // namespace
+
+void ImageProviderBorderImage::registerTypes(QQmlEngine& engine)
+{
+    engine.addImageProvider("UtilsQt-BorderImage", new ImageProviderBorderImage());
+}
+
+void ImageProviderBorderImage::setCacheLimit(qint64 bytes)
+{
+    outputCache().setLimit(bytes);
+}
+
+void ImageProviderBorderImage::clearCache()
+{
+    outputCache().clear();
+    sourceCache().clear();
+}
+
+QImage ImageProviderBorderImage::requestImage(const QString& id, QSize* size, const QSize& requestedSize)
+{
+    assert(size);
+
+    if (requestedSize.width() <= 0 || requestedSize.height() <= 0) {
+        QImage stub(10, 10, QImage::Format_ARGB32);
+        stub.fill(QColor::fromRgbF(0.5, 0.5, 0.5));
+        *size = stub.size();
+        return stub;
+    }
+
+    // Return final image size as requested.
+    *size = requestedSize;
+
+    const auto params = sourceCache().params(id);
+    const QString normalizedPath = QmlUtils::instance().normalizePath(params.path);
+
+    const QFileInfo fileInfo(normalizedPath);
+    const auto modified = fileInfo.lastModified().toMSecsSinceEpoch();
+    const auto fileSize = fileInfo.size();
+
+    auto& cache = outputCache();
+
+    if (auto cached = cache.get(id, requestedSize, modified, fileSize))
+        return *cached;
+
+    // Compute the scale factor based on the orientation.
+    double scaleFactor = 1.0;
+    auto scaledSizeFunc = [&](const QSize& origSize) {
+        if (params.orientation == Orientation::Vertical) {
+            scaleFactor = double(requestedSize.width()) / double(origSize.width());
+        } else if (params.orientation == Orientation::Horizontal) {
+            scaleFactor = double(requestedSize.height()) / double(origSize.height());
+        }
+
+        // Scale the entire source image proportionally.
+        return QSize(qRound(origSize.width() * scaleFactor), qRound(origSize.height() * scaleFactor));
+    };
+
+    const auto scaledImage = sourceCache().scaledSource(normalizedPath, modified, fileSize, scaledSizeFunc);
+
+    if (scaledImage.isNull()) {
+        qWarning() << "Failed to load source image:" << normalizedPath;
+        QImage failed(requestedSize, QImage::Format_ARGB32);
+        failed.fill(Qt::transparent);
+        return failed;
+    }
+
+    const auto result = render(params, scaledImage, requestedSize, scaleFactor);
+    cache.insert(id, requestedSize, modified, fileSize, result);
+    return result;
+}
@@ -5,15 +5,132 @@
 #include <UtilsQt/Qml/ImageProviderScaled.h>
 
 #include <UtilsQt/Qml-Cpp/QmlUtils.h>
+#include <UtilsQt/Futures/Utils.h>
+#include "ImageCache.h"
 #include <QString>
 #include <QImage>
+#include <QImageReader>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QFutureWatcher>
 #include <QQmlEngine>
 
+namespace {
+
+ImageCache& scaledImageCache()
+{
+    static ImageCache cache(ImageProviderScaled::DefaultCacheLimit);
+    return cache;
+}
+
+QImage stubImage()
+{
+    QImage stub(1, 1, QImage::Format::Format_ARGB32);
+    stub.fill(QColor::fromRgbF(0.5, 0.5, 0.5));
+    return stub;
+}
+
+QImage loadScaled(const QString& id, QSize* size, const QSize& requestedSize)
+{
+    auto& utils = QmlUtils::instance();
+
+    const auto metadata = utils.imageMetadata(id);
+    assert(metadata.isValid() && metadata.size.isValid() && !metadata.size.isNull());
+
+    if (size)
+        *size = metadata.size;
+
+    const auto path = utils.normalizePath(id);
+    const QFileInfo fileInfo(path);
+    const auto modified = fileInfo.lastModified().toMSecsSinceEpoch();
+    const auto fileSize = fileInfo.size();
+
+    auto& cache = scaledImageCache();
+
+    if (auto cached = cache.get(path, requestedSize, modified, fileSize))
+        return *cached;
+
+    // Decoders supporting QImageIOHandler::ScaledSize (e.g. JPEG) skip full-resolution decoding,
+    // others are scaled by the reader itself.
+    QImageReader reader(path, metadata.format);
+    reader.setScaledSize(requestedSize);
+    QImage image = reader.read();
+    assert(!image.isNull());
+
+    if (!image.isNull() && image.size() != requestedSize)
+        image = image.scaled(requestedSize,
+                             Qt::AspectRatioMode::IgnoreAspectRatio,
+                             Qt::TransformationMode::SmoothTransformation);
+
+    if (!image.isNull())
+        cache.insert(path, requestedSize, modified, fileSize, image);
+
+    return image;
+}
+
+class ScaledImageResponse : public QQuickImageResponse
+{
+public:
+    ScaledImageResponse(const QString& id, const QSize& requestedSize, QThreadPool& pool)
+    {
+        QObject::connect(&m_watcher, &QFutureWatcherBase::finished, this, [this]() {
+            if (!m_watcher.isCanceled() && m_watcher.future().resultCount())
+                m_image = m_watcher.result();
+
+            emit finished();
+        });
+
+        UtilsQt::Promise<QImage> promise(true);
+        m_watcher.setFuture(promise.future());
+
+        pool.start([promise, id, requestedSize]() mutable {
+            if (promise.isCanceled()) {
+                promise.cancel();
+                return;
+            }
+
+            const bool isSizeValid = requestedSize.width() > 0 && requestedSize.height() > 0;
+            promise.finish(isSizeValid ? loadScaled(id, nullptr, requestedSize) : stubImage());
+        });
+    }
+
+    QQuickTextureFactory* textureFactory() const override
+    {
+        return QQuickTextureFactory::textureFactoryForImage(m_image);
+    }
+
+    QString errorString() const override
+    {
+        return m_image.isNull() && !m_watcher.isCanceled() ? QStringLiteral("Failed to load image") : QString();
+    }
+
+    void cancel() override
+    {
+        m_watcher.cancel();
+    }
+
+private:
+    QFutureWatcher<QImage> m_watcher;
+    QImage m_image;
+};
+
+} // namespace
+
 void ImageProviderScaled::registerTypes(QQmlEngine& engine)
 {
     engine.addImageProvider("UtilsQt-Scaled", new ImageProviderScaled());
 }
 
+void ImageProviderScaled::setCacheLimit(qint64 bytes)
+{
+    scaledImageCache().setLimit(bytes);
+}
+
+void ImageProviderScaled::clearCache()
+{
+    scaledImageCache().clear();
+}
+
 QImage ImageProviderScaled::requestImage(const QString& id,
                                            QSize* size,
                                            const QSize& requestedSize)
@@ -22,21 +139,20 @@ QImage ImageProviderScaled::requestImage(const QString& id,
     assert(size);
 
     if (requestedSize.width() <= 0 || requestedSize.height() <= 0) {
-        QImage stub(1, 1, QImage::Format::Format_ARGB32);
-        stub.fill(QColor::fromRgbF(0.5, 0.5, 0.5));
+        const auto stub = stubImage();
         *size = stub.size();
         return stub;
     }
 
-    const auto sourceSize = QmlUtils::instance().imageSize(id);
-    assert(sourceSize.isValid() && !sourceSize.isNull());
-    *size = sourceSize;
+    return loadScaled(id, size, requestedSize);
+}
 
-    const auto path = QmlUtils::instance().normalizePath(id);
-    const QImage image(path);
-    assert(!image.isNull());
+void ImageProviderScaledAsync::registerTypes(QQmlEngine& engine)
+{
+    engine.addImageProvider("UtilsQt-ScaledAsync", new ImageProviderScaledAsync());
+}
 
-    return image.scaled(requestedSize,
-                        Qt::AspectRatioMode::IgnoreAspectRatio,
-                        Qt::TransformationMode::SmoothTransformation);
+QQuickImageResponse* ImageProviderScaledAsync::requestImageResponse(const QString& id, const QSize& requestedSize)
+{
+    return new ScaledImageResponse(id, requestedSize, m_threadPool);
 }
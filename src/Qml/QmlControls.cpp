@@ -24,6 +24,7 @@ void init(QQmlEngine& qmlEngine) {
     ListModelItemProxy::registerTypes();
     ListModelTools::registerTypes();
     ImageProviderScaled::registerTypes(qmlEngine);
+    ImageProviderScaledAsync::registerTypes(qmlEngine);
     ImageProviderBorderImage::registerTypes(qmlEngine);
 }
 
@@ -0,0 +1,56 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/utils-qt
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <QSemaphore>
+#include <QThreadPool>
+#include <atomic>
+#include <exception>
+#include <mutex>
+
+// Calls func(chunk) for each chunk in [0, chunks): chunk 0 and chunks which the pool can't take
+// right away run on the calling thread, the rest run on the pool. Returns when all chunks are done.
+// If a chunk throws, chunks which haven't started yet are skipped and the first exception is rethrown.
+template<typename Func>
+void runChunked(QThreadPool* pool, int chunks, const Func& func)
+{
+    if (chunks <= 0)
+        return;
+
+    std::atomic<bool> failed {false};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto guarded = [&func, &failed, &error, &errorMutex](int chunk) {
+        if (failed.load(std::memory_order_relaxed))
+            return;
+
+        try {
+            func(chunk);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error)
+                error = std::current_exception();
+            failed = true;
+        }
+    };
+
+    QSemaphore done;
+    int started = 0;
+
+    for (int chunk = 1; chunk < chunks; chunk++) {
+        // Don't block on busy pool, process the chunk here instead
+        if (pool && pool->tryStart([&guarded, &done, chunk]() { guarded(chunk); done.release(); })) {
+            started++;
+        } else {
+            guarded(chunk);
+        }
+    }
+
+    guarded(0);
+    done.acquire(started);
+
+    if (error)
+        std::rethrow_exception(error);
+}
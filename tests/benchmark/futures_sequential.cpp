@@ -0,0 +1,102 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/utils-qt
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <benchmark/benchmark.h>
+
+#include <QCoreApplication>
+#include <UtilsQt/Futures/Sequential.h>
+#include <UtilsQt/Futures/Utils.h>
+
+namespace {
+
+const UtilsQt::SequentialMediator& sharedMediator()
+{
+    static const UtilsQt::SequentialMediator mediator;
+    return mediator;
+}
+
+QFuture<int> nextStep(const UtilsQt::AsyncResult<int>& r)
+{
+    return UtilsQt::createReadyFuture(r.value() + 1);
+}
+
+void processEvents()
+{
+    QCoreApplication::processEvents();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+}
+
+} // namespace
+
+// Many threads polling the cancellation state of the same mediator
+static void SequentialMediator_IsCancelRequested(benchmark::State& state)
+{
+    const auto& sm = sharedMediator();
+
+    while (state.KeepRunning())
+        benchmark::DoNotOptimize(sm.isCancelRequested());
+}
+
+BENCHMARK(SequentialMediator_IsCancelRequested)->ThreadRange(1, 16)->UseRealTime();
+
+// Many threads subscribing to / unsubscribing from cancellation of the same mediator
+static void SequentialMediator_OnCancellation(benchmark::State& state)
+{
+    const auto& sm = sharedMediator();
+
+    while (state.KeepRunning()) {
+        auto subscription = sm.onCancellation([](){});
+        benchmark::DoNotOptimize(subscription);
+    }
+}
+
+BENCHMARK(SequentialMediator_OnCancellation)->ThreadRange(1, 16)->UseRealTime();
+
+// Baseline for the next benchmark: the same 10 ready futures without a chain
+static void Sequential_ReadyFutures_Baseline(benchmark::State& state)
+{
+    while (state.KeepRunning()) {
+        auto f = UtilsQt::createReadyFuture(0);
+
+        for (int i = 1; i < 10; i++)
+            f = UtilsQt::createReadyFuture(f.result() + 1);
+
+        benchmark::DoNotOptimize(f.result());
+    }
+}
+
+BENCHMARK(Sequential_ReadyFutures_Baseline);
+
+// 10-step chain, where every step returns ready future
+static void Sequential_ReadyChain_10Steps(benchmark::State& state)
+{
+    QObject ctx;
+
+    while (state.KeepRunning()) {
+        auto f = UtilsQt::Sequential(&ctx)
+                     .start([](){ return UtilsQt::createReadyFuture(0); })
+                     .then(&nextStep).then(&nextStep).then(&nextStep)
+                     .then(&nextStep).then(&nextStep).then(&nextStep)
+                     .then(&nextStep).then(&nextStep).then(&nextStep)
+                     .execute();
+
+        benchmark::DoNotOptimize(f.result());
+
+        state.PauseTiming();
+        processEvents();
+        state.ResumeTiming();
+    }
+}
+
+BENCHMARK(Sequential_ReadyChain_10Steps);
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/utils-qt
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <benchmark/benchmark.h>
+
+#include <QPolygonF>
+#include <QTransform>
+#include <QVector>
+#include <UtilsQt/Qml-Cpp/Geometry/Geometry.h>
+
+namespace {
+
+// state.range(0) polygons of 64 points
+QVector<QPolygonF> makePolygons(int count)
+{
+    QVector<QPolygonF> result;
+    result.reserve(count);
+
+    for (int i = 0; i < count; i++) {
+        QPolygonF polygon;
+        polygon.reserve(64);
+
+        for (int j = 0; j < 64; j++)
+            polygon.append(QPointF(i + j * 0.5, i - j * 0.25));
+
+        result.append(polygon);
+    }
+
+    return result;
+}
+
+QTransform zoomTransform()
+{
+    QTransform transform;
+    transform.translate(12, -7).rotate(15).scale(1.01, 0.99);
+    return transform;
+}
+
+} // namespace
+
+// Zoom step: rescale and get bounds. Per-point QTransform::map + boundingRect (0) vs batch kernel (1).
+// Zoom in and out alternate, so coordinates don't drift to inf/NaN/denormals over iterations.
+static void Geometry_TransformWithBounds(benchmark::State& state)
+{
+    auto polygons = makePolygons(static_cast<int>(state.range(0)));
+    const QTransform transforms[] = {zoomTransform(), zoomTransform().inverted()};
+    const bool useKernel = state.range(1) != 0;
+    int step = 0;
+
+    while (state.KeepRunning()) {
+        const auto& transform = transforms[step++ % 2];
+        QRectF bounds;
+
+        if (useKernel) {
+            bounds = Geometry::instance().polygonsTransformRef(polygons, transform);
+        } else {
+            for (auto& polygon : polygons) {
+                for (auto& p : polygon)
+                    p = transform.map(p);
+
+                bounds |= polygon.boundingRect();
+            }
+        }
+
+        benchmark::DoNotOptimize(bounds);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 64);
+}
+
+BENCHMARK(Geometry_TransformWithBounds)->Args({100, 0})->Args({100, 1})->Args({10000, 0})->Args({10000, 1});
+
+// Plain scaling: generic per-point loop (0) vs batch kernel (1). Scaling up and down alternate, as above.
+static void Geometry_Scale(benchmark::State& state)
+{
+    auto polygons = makePolygons(static_cast<int>(state.range(0)));
+    const bool useKernel = state.range(1) != 0;
+    const double scales[][2] = {{1.01, 0.99}, {1 / 1.01, 1 / 0.99}};
+    int step = 0;
+
+    while (state.KeepRunning()) {
+        const auto sx = scales[step % 2][0];
+        const auto sy = scales[step % 2][1];
+        step++;
+
+        if (useKernel) {
+            Geometry::instance().polygonsScaleRef(polygons, sx, sy);
+        } else {
+            for (auto& polygon : polygons) {
+                for (auto& p : polygon) {
+                    p.rx() *= sx;
+                    p.ry() *= sy;
+                }
+            }
+        }
+
+        benchmark::DoNotOptimize(polygons);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 64);
+}
+
+BENCHMARK(Geometry_Scale)->Args({100, 0})->Args({100, 1})->Args({10000, 0})->Args({10000, 1});
+
+static void Geometry_BoundingRect(benchmark::State& state)
+{
+    const auto polygons = makePolygons(static_cast<int>(state.range(0)));
+    const bool useKernel = state.range(1) != 0;
+
+    while (state.KeepRunning()) {
+        QRectF bounds;
+
+        if (useKernel) {
+            bounds = Geometry::instance().polygonsBoundingRect(polygons);
+        } else {
+            for (const auto& polygon : polygons)
+                bounds |= polygon.boundingRect();
+        }
+
+        benchmark::DoNotOptimize(bounds);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 64);
+}
+
+BENCHMARK(Geometry_BoundingRect)->Args({100, 0})->Args({100, 1})->Args({10000, 0})->Args({10000, 1});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,82 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/utils-qt
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <benchmark/benchmark.h>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QImage>
+#include <QTemporaryDir>
+#include <UtilsQt/Qml/ImageProviderBorderImage.h>
+
+namespace {
+
+QString assetId(bool tile)
+{
+    static QTemporaryDir dir;
+    static const QString path = [](){
+        const auto path = QDir(dir.path()).filePath("frame.png");
+        QImage image(64, 64, QImage::Format_ARGB32);
+        image.fill(Qt::darkGray);
+        image.save(path, "PNG");
+        return path;
+    }();
+
+    return QString("path=%1&orientation=vertical&top=16&bottom=16&left=16&right=16&fill=%2").arg(path, tile ? "tile" : "stretch");
+}
+
+// Window is resized by user: width is fixed, height changes in small steps and back
+void resizeSequence(ImageProviderBorderImage& provider, const QString& id)
+{
+    QSize size;
+
+    for (int height = 200; height < 400; height += 10)
+        benchmark::DoNotOptimize(provider.requestImage(id, &size, {300, height}));
+
+    for (int height = 400; height > 200; height -= 10)
+        benchmark::DoNotOptimize(provider.requestImage(id, &size, {300, height}));
+}
+
+} // namespace
+
+// Every size is rendered from scratch
+static void ImageProviderBorderImage_Resize_Cold(benchmark::State& state)
+{
+    ImageProviderBorderImage provider;
+    const auto id = assetId(state.range(0) != 0);
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        ImageProviderBorderImage::clearCache();
+        state.ResumeTiming();
+
+        resizeSequence(provider, id);
+    }
+}
+
+BENCHMARK(ImageProviderBorderImage_Resize_Cold)->Arg(0)->Arg(1);
+
+// Same sequence again, results are cached
+static void ImageProviderBorderImage_Resize_Warm(benchmark::State& state)
+{
+    ImageProviderBorderImage provider;
+    const auto id = assetId(state.range(0) != 0);
+    ImageProviderBorderImage::clearCache();
+    resizeSequence(provider, id);
+
+    while (state.KeepRunning())
+        resizeSequence(provider, id);
+}
+
+BENCHMARK(ImageProviderBorderImage_Resize_Warm)->Arg(0)->Arg(1);
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
@@ -0,0 +1,218 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/utils-qt
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <benchmark/benchmark.h>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <UtilsQt/JsonValidator.h>
+
+namespace {
+
+using namespace UtilsQt::JsonValidator;
+
+QJsonObject makeDocument(int records)
+{
+    QJsonArray items;
+
+    for (int i = 0; i < records; i++) {
+        QJsonObject item;
+        item["id"] = i;
+        item["name"] = QString("item-%1").arg(i);
+        item["enabled"] = (i % 2 == 0);
+        item["tags"] = QJsonArray{"a", "b"};
+        items.append(item);
+    }
+
+    QJsonObject root;
+    root["items"] = items;
+    return root;
+}
+
+const RootValidatorCPtr& recordsValidator()
+{
+    static const auto validator =
+        RootValidator(
+          Object(
+            Field("items", Array(
+              Object(
+                Field("id", Number(Integer, {0}, {})),
+                Field("name", String(NonEmpty)),
+                Field("enabled", Bool()),
+                Field("tags", Array(String()))
+              )
+            ))
+          )
+        );
+
+    return validator;
+}
+
+} // namespace
+
+// Baseline for the next benchmark: path strings which were built for every visited element and field
+// before paths became lazy. Validation no longer pays this.
+static void JsonValidator_LargeArray_EagerPaths_Baseline(benchmark::State& state)
+{
+    const QJsonValue document = makeDocument(static_cast<int>(state.range(0)));
+
+    while (state.KeepRunning()) {
+        const QString itemsPath = QString() + "/" + "items";
+        const auto items = document.toObject().value("items").toArray();
+
+        for (int i = 0; i < items.size(); i++) {
+            const auto itemPath = itemsPath + QString("[%1]").arg(i);
+            const auto item = items.at(i).toObject();
+
+            for (const auto& key : {"id", "name", "enabled", "tags"})
+                benchmark::DoNotOptimize(itemPath + "/" + key);
+
+            const auto tagsPath = itemPath + "/" + "tags";
+            const auto tags = item.value("tags").toArray();
+
+            for (int j = 0; j < tags.size(); j++)
+                benchmark::DoNotOptimize(tagsPath + QString("[%1]").arg(j));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(JsonValidator_LargeArray_EagerPaths_Baseline)->Arg(1000)->Arg(200000)->Unit(benchmark::kMillisecond);
+
+// Valid document, so no error is reported and no path string is built
+static void JsonValidator_LargeArray(benchmark::State& state)
+{
+    const QJsonValue document = makeDocument(static_cast<int>(state.range(0)));
+    const auto& validator = recordsValidator();
+
+    while (state.KeepRunning()) {
+        ErrorInfo errorInfo;
+        benchmark::DoNotOptimize(validator->check(errorInfo, document));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(JsonValidator_LargeArray)->Arg(1000)->Arg(200000)->Unit(benchmark::kMillisecond);
+
+// Same document, compiled validator
+static void JsonValidator_LargeArray_Compiled(benchmark::State& state)
+{
+    const QJsonValue document = makeDocument(static_cast<int>(state.range(0)));
+    const auto compiled = Compile(recordsValidator());
+
+    while (state.KeepRunning()) {
+        ErrorInfo errorInfo;
+        benchmark::DoNotOptimize(compiled->check(errorInfo, document));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(JsonValidator_LargeArray_Compiled)->Arg(1000)->Arg(200000)->Unit(benchmark::kMillisecond);
+
+// Same document, compiled validator, elements are checked in global thread pool
+static void JsonValidator_LargeArray_Parallel(benchmark::State& state)
+{
+    const QJsonValue document = makeDocument(static_cast<int>(state.range(0)));
+    const auto compiled = Compile(recordsValidator());
+
+    ParallelOptions parallel;
+    parallel.enabled = true;
+
+    while (state.KeepRunning()) {
+        ErrorInfo errorInfo;
+        benchmark::DoNotOptimize(compiled->check(errorInfo, document, parallel));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(JsonValidator_LargeArray_Parallel)->Arg(1000)->Arg(200000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Same document as UTF-8 bytes: parse to QJsonDocument, then validate (0) vs streaming validation (1)
+static void JsonValidator_LargeArray_Utf8(benchmark::State& state)
+{
+    const auto bytes = QJsonDocument(makeDocument(static_cast<int>(state.range(0)))).toJson(QJsonDocument::Compact);
+    const auto compiled = Compile(recordsValidator());
+    const bool useStream = state.range(1) != 0;
+
+    while (state.KeepRunning()) {
+        ErrorInfo errorInfo;
+
+        if (useStream) {
+            benchmark::DoNotOptimize(compiled->checkUtf8(errorInfo, bytes));
+        } else {
+            const QJsonValue document = QJsonDocument::fromJson(bytes).object();
+            benchmark::DoNotOptimize(compiled->check(errorInfo, document));
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+
+BENCHMARK(JsonValidator_LargeArray_Utf8)->Args({1000, 0})->Args({1000, 1})->Args({200000, 0})->Args({200000, 1})->Unit(benchmark::kMillisecond);
+
+// Typical IPC message: type-dispatched union of payloads
+static void JsonValidator_Message_Or(benchmark::State& state)
+{
+    const auto validator =
+        RootValidator(
+          Object(
+            Field("id", Number(Integer)),
+            Field("payload", Or(Bool(), String(), Array(Number()), Object(Field("value", Number()))))
+          )
+        );
+
+    const auto compiled = Compile(validator);
+    const bool useCompiled = state.range(0) != 0;
+
+    QJsonObject message;
+    message["id"] = 1;
+    message["payload"] = QJsonObject{{"value", 5}};
+    const QJsonValue value = message;
+
+    while (state.KeepRunning()) {
+        ErrorInfo errorInfo;
+        benchmark::DoNotOptimize(useCompiled ? compiled->check(errorInfo, value) : validator->check(errorInfo, value));
+    }
+}
+
+BENCHMARK(JsonValidator_Message_Or)->Arg(0)->Arg(1);
+
+// References between two arrays via context list
+static void JsonValidator_CtxCrossReference(benchmark::State& state)
+{
+    const auto validator =
+        RootValidator(
+          Object(
+            Field("keys", Array(CtxAppendToList("keys"))),
+            Field("refs", Array(CtxCheckInList("keys")))
+          ),
+          CtxClearRecord("keys")
+        );
+
+    QJsonArray keys;
+    QJsonArray refs;
+
+    for (int i = 0; i < state.range(0); i++) {
+        keys.append(QString("key-%1").arg(i));
+        refs.append(QString("key-%1").arg(i / 2));
+    }
+
+    const QJsonValue document = QJsonObject{{"keys", keys}, {"refs", refs}};
+
+    while (state.KeepRunning()) {
+        ErrorInfo errorInfo;
+        benchmark::DoNotOptimize(validator->check(errorInfo, document));
+    }
+
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(JsonValidator_CtxCrossReference)->RangeMultiplier(4)->Range(256, 16384)->Complexity();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,97 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/utils-qt
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <benchmark/benchmark.h>
+
+#include <QFont>
+#include <QStringList>
+#include <QThreadPool>
+#include <UtilsQt/Qml-Cpp/PathElider.h>
+
+#ifdef UTILS_QT_NO_GUI_TESTS
+#include <QCoreApplication>
+#else
+#include <QGuiApplication>
+#endif
+
+#ifndef UTILS_QT_NO_GUI_TESTS
+namespace {
+
+// File list: the same directories, different names
+QStringList filePaths(int count)
+{
+    QStringList result;
+    result.reserve(count);
+
+    for (int i = 0; i < count; i++)
+        result.append(QString("/home/user/projects/utils-qt/tests/data/set_%1/file_with_a_rather_long_name_%2.json").arg(i % 10).arg(i));
+
+    return result;
+}
+
+} // namespace
+
+// Each row is elided by its own PathElider, as in a delegate
+static void PathElider_FileList(benchmark::State& state)
+{
+    const auto paths = filePaths(static_cast<int>(state.range(0)));
+    const QFont font {QString("Arial")};
+
+    while (state.KeepRunning()) {
+        for (const auto& path : paths) {
+            PathElider elider;
+            elider.setFont(font);
+            elider.setSourceText(path);
+            elider.setWidthLimit(static_cast<int>(state.range(1)));
+            benchmark::DoNotOptimize(elider.elidedText());
+        }
+    }
+}
+
+BENCHMARK(PathElider_FileList)->Args({1000, 150})->Args({1000, 40})->Unit(benchmark::kMillisecond);
+
+// Same list in one call, sequentially or on a thread pool
+static void PathElider_ElideAll(benchmark::State& state)
+{
+    const auto paths = filePaths(static_cast<int>(state.range(0)));
+    const QFont font {QString("Arial")};
+    QThreadPool pool;
+
+    while (state.KeepRunning())
+        benchmark::DoNotOptimize(PathElider::elideAll(paths, font, static_cast<int>(state.range(1)), state.range(2) ? &pool : nullptr));
+}
+
+BENCHMARK(PathElider_ElideAll)->Args({1000, 150, 0})->Args({1000, 40, 0})->Args({20000, 150, 0})->Args({20000, 150, 1})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Width changes in small steps, as when a view is resized
+static void PathElider_Resize(benchmark::State& state)
+{
+    PathElider elider;
+    elider.setFont(QFont(QString("Arial")));
+    elider.setSourceText(filePaths(1).front());
+
+    while (state.KeepRunning()) {
+        for (int width = 400; width > 20; width -= 5) {
+            elider.setWidthLimit(width);
+            benchmark::DoNotOptimize(elider.elidedText());
+        }
+    }
+}
+
+BENCHMARK(PathElider_Resize);
+#endif // !UTILS_QT_NO_GUI_TESTS
+
+int main(int argc, char** argv)
+{
+#ifdef UTILS_QT_NO_GUI_TESTS
+    QCoreApplication app(argc, argv);
+#else
+    QGuiApplication app(argc, argv);
+#endif
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
@@ -7,6 +7,13 @@
 #include <UtilsQt/Futures/Utils.h>
 #include <QCoreApplication>
 #include <QEventLoop>
+#include <QThread>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "internal/TestWaitHelpers.h"
 
 #include "internal/LifetimeTracker.h"
 
@@ -394,3 +401,137 @@ TEST(UtilsQt, Futures_Convert_Lifetime)
     qApp->processEvents();
     ASSERT_EQ(tracker.count(), 1);
 }
+
+TEST(UtilsQt, Futures_Convert_ThreadPool)
+{
+    QObject ctx;
+    QThread* converterThread {};
+
+    auto f = convertFuture(&ctx, createTimedFuture(10, 12), ConverterFlags::RunInThreadPool, [&converterThread](const int& value) {
+        converterThread = QThread::currentThread();
+        return std::to_string(value);
+    });
+
+    waitForFuture<QEventLoop>(f);
+    ASSERT_TRUE(f.isFinished());
+    ASSERT_FALSE(f.isCanceled());
+    ASSERT_EQ(f.result(), "12");
+    ASSERT_NE(converterThread, QThread::currentThread());
+
+    // Explicit pool + ready source + nullopt
+    QThreadPool pool;
+    auto f2 = convertFuture(&ctx, createReadyFuture(12), {}, &pool, [](int) -> std::optional<int> { return {}; });
+    waitForFuture<QEventLoop>(f2);
+    ASSERT_TRUE(f2.isFinished());
+    ASSERT_TRUE(f2.isCanceled());
+}
+
+TEST(UtilsQt, Futures_Convert_ThreadPool_ContextDestroyed)
+{
+    std::atomic<bool> started {false};
+    std::atomic<bool> release {false};
+
+    auto ctx = std::make_unique<QObject>();
+    auto f = convertFuture(ctx.get(), createReadyFuture(12), ConverterFlags::RunInThreadPool, [&](int value) {
+        started = true;
+        while (!release) std::this_thread::yield();
+        return value;
+    });
+
+    ASSERT_TRUE(TestHelpers::waitForFlag(started));
+    ctx.reset();
+    ASSERT_TRUE(f.isFinished());
+    ASSERT_TRUE(f.isCanceled());
+
+    release = true;
+    QThreadPool::globalInstance()->waitForDone();
+    ASSERT_TRUE(f.isCanceled());
+    ASSERT_EQ(f.resultCount(), 0);
+}
+
+TEST(UtilsQt, Futures_Convert_ThreadPool_CancelTarget)
+{
+    std::atomic<bool> started {false};
+    std::atomic<bool> release {false};
+
+    QObject ctx;
+    auto f = convertFuture(&ctx, createReadyFuture(12), ConverterFlags::RunInThreadPool, [&](int value) {
+        started = true;
+        while (!release) std::this_thread::yield();
+        return value;
+    });
+
+    ASSERT_TRUE(TestHelpers::waitForFlag(started));
+    f.cancel();
+    release = true;
+
+    waitForFuture<QEventLoop>(f);
+    ASSERT_TRUE(f.isFinished());
+    ASSERT_TRUE(f.isCanceled());
+    ASSERT_EQ(f.resultCount(), 0);
+}
+
+TEST(UtilsQt, Futures_Convert_Chain)
+{
+    QObject ctx;
+    Promise<QString> promise(true);
+
+    auto f = convertChain(&ctx, promise.future())
+                 .map([](const QString& s) { return s.toInt(); })
+                 .filter([](int value) { return value > 0; })
+                 .map([](int value) -> std::optional<std::string> { return std::to_string(value * 2); })
+                 .map([](std::string s) { return s + "!"; })
+                 .execute();
+
+    static_assert(std::is_same_v<decltype(f), QFuture<std::string>>, "Wrong chain type");
+    ASSERT_EQ(ctx.children().size(), 1); // Single conversion context for whole chain
+
+    promise.finish("21");
+    waitForFuture<QEventLoop>(f);
+    ASSERT_TRUE(f.isFinished());
+    ASSERT_FALSE(f.isCanceled());
+    ASSERT_EQ(f.result(), "42!");
+}
+
+TEST(UtilsQt, Futures_Convert_Chain_Cancel)
+{
+    QObject ctx;
+    int lastStageCalls = 0;
+
+    auto makeChain = [&](const QFuture<int>& source) {
+        return convertChain(&ctx, source)
+            .filter([](int value) { return value != 0; })
+            .map([](int value) -> std::optional<int> { if (value < 0) return {}; return value; })
+            .map([&lastStageCalls](int value) { lastStageCalls++; return value; })
+            .execute();
+    };
+
+    auto f1 = makeChain(createReadyFuture(0));  // Filtered out
+    auto f2 = makeChain(createReadyFuture(-1)); // nullopt
+    auto f3 = makeChain(createCanceledFuture<int>());
+    auto f4 = makeChain(createReadyFuture(5));
+
+    waitForFuture<QEventLoop>(f4);
+    ASSERT_TRUE(f1.isCanceled());
+    ASSERT_TRUE(f2.isCanceled());
+    ASSERT_TRUE(f3.isCanceled());
+    ASSERT_FALSE(f4.isCanceled());
+    ASSERT_EQ(f4.result(), 5);
+    ASSERT_EQ(lastStageCalls, 1);
+
+    // Null context
+    auto f5 = convertChain(nullptr, createReadyFuture(1)).map([](int x) { return x; }).execute();
+    ASSERT_TRUE(f5.isCanceled());
+}
+
+TEST(UtilsQt, Futures_Convert_Chain_VoidSource)
+{
+    auto f = convertChain(nullptr, createReadyFuture(), ConverterFlags::IgnoreNullContext)
+                 .map([]() { return 10; })
+                 .map([](int x) { return QString::number(x); })
+                 .execute();
+
+    waitForFuture<QEventLoop>(f);
+    ASSERT_FALSE(f.isCanceled());
+    ASSERT_EQ(f.result(), "10");
+}
@@ -7,6 +7,7 @@
 #include <QCoreApplication>
 #include <QEventLoop>
 #include <QString>
+#include <memory>
 
 class Futures_SignalToFuture_TestClass : public QObject
 {
@@ -157,4 +158,132 @@ TEST(UtilsQt, Futures_SignalToFuture_Timeout)
     ASSERT_FALSE(f.isCanceled());
 }
 
+TEST(UtilsQt, Futures_SignalToFuture_ContextReuse)
+{
+    using Class = Futures_SignalToFuture_TestClass;
+    Class obj;
+
+    for (int i = 0; i < 1000; i++) {
+        auto f = signalToFuture(&obj, &Class::someSignal2);
+        obj.trigger2();
+        ASSERT_TRUE(f.isFinished());
+        ASSERT_FALSE(f.isCanceled());
+        ASSERT_EQ(f.result(), "Test");
+    }
+
+    // Pending timer of released context mustn't affect next user of the same context
+    auto f1 = signalToFuture(&obj, &Class::someSignal1, nullptr, 50);
+    obj.trigger1();
+    ASSERT_TRUE(f1.isFinished());
+
+    auto f2 = signalToFuture(&obj, &Class::someSignal1);
+    waitForFuture<QEventLoop>(createTimedFuture(100));
+    ASSERT_FALSE(f2.isFinished());
+
+    obj.trigger1();
+    ASSERT_TRUE(f2.isFinished());
+    ASSERT_FALSE(f2.isCanceled());
+}
+
+TEST(UtilsQt, Futures_SignalToStream_Count)
+{
+    using Class = Futures_SignalToFuture_TestClass;
+    Class obj;
+
+    auto f1 = signalToStream(&obj, &Class::someSignal1, 2);
+    auto f2 = signalToStream(&obj, &Class::someSignal2, 2);
+    auto f3 = signalToStream(&obj, &Class::someSignal3, 3);
+
+    static_assert (std::is_same_v<decltype(f1), QFuture<QVector<std::tuple<>>>>, "Wrong return type for case 1");
+    static_assert (std::is_same_v<decltype(f2), QFuture<QVector<QString>>>, "Wrong return type for case 2");
+    static_assert (std::is_same_v<decltype(f3), QFuture<QVector<std::tuple<QString, int>>>>, "Wrong return type for case 3");
+
+    obj.trigger1();
+    obj.trigger2();
+    obj.trigger3();
+    obj.trigger3();
+    ASSERT_FALSE(f1.isFinished());
+    ASSERT_FALSE(f2.isFinished());
+    ASSERT_FALSE(f3.isFinished());
+
+    obj.trigger1();
+    obj.trigger2();
+    obj.trigger3();
+    ASSERT_TRUE(f1.isFinished());
+    ASSERT_TRUE(f2.isFinished());
+    ASSERT_TRUE(f3.isFinished());
+
+    obj.trigger2(); // Ignored
+
+    ASSERT_EQ(f1.result().size(), 2);
+    ASSERT_EQ(f2.result(), QVector<QString>({"Test", "Test"}));
+    ASSERT_EQ(f3.result().size(), 3);
+    ASSERT_EQ(f3.result().at(2), std::make_tuple(QString("Test"), 12));
+}
+
+TEST(UtilsQt, Futures_SignalToStream_Predicate)
+{
+    using Class = Futures_SignalToFuture_TestClass;
+    Class obj;
+
+    int counter = 0;
+    auto f = signalToStream(&obj, &Class::someSignal2, [&counter](const QString&) { return ++counter == 3; });
+
+    obj.trigger2();
+    obj.trigger2();
+    ASSERT_FALSE(f.isFinished());
+
+    obj.trigger2();
+    ASSERT_TRUE(f.isFinished());
+    ASSERT_FALSE(f.isCanceled());
+    ASSERT_EQ(f.result().size(), 3);
+}
+
+TEST(UtilsQt, Futures_SignalToStream_Timeout)
+{
+    using Class = Futures_SignalToFuture_TestClass;
+    Class obj;
+
+    // Unlimited count, finished by timeout with collected items
+    auto f = signalToStream(&obj, &Class::someSignal2, 0, nullptr, std::chrono::milliseconds(100));
+    obj.trigger2();
+    obj.trigger2();
+    ASSERT_FALSE(f.isFinished());
+
+    waitForFuture<QEventLoop>(createTimedFuture(200));
+    ASSERT_TRUE(f.isFinished());
+    ASSERT_FALSE(f.isCanceled());
+    ASSERT_EQ(f.result().size(), 2);
+
+    // Nothing emitted
+    f = signalToStream(&obj, &Class::someSignal2, 5, nullptr, std::chrono::milliseconds(50));
+    waitForFuture<QEventLoop>(createTimedFuture(100));
+    ASSERT_TRUE(f.isFinished());
+    ASSERT_FALSE(f.isCanceled());
+    ASSERT_TRUE(f.result().isEmpty());
+}
+
+TEST(UtilsQt, Futures_SignalToStream_Context)
+{
+    using Class = Futures_SignalToFuture_TestClass;
+
+    auto obj = std::make_shared<Class>();
+    auto f = signalToStream(obj.get(), &Class::someSignal2, 2);
+    obj->trigger2();
+
+    obj.reset();
+    waitForFuture<QEventLoop>(f);
+    ASSERT_TRUE(f.isFinished());
+    ASSERT_TRUE(f.isCanceled());
+
+    obj = std::make_shared<Class>();
+    auto obj2 = std::make_shared<QObject>();
+    f = signalToStream(obj.get(), &Class::someSignal2, 2, obj2.get());
+
+    obj2.reset();
+    waitForFuture<QEventLoop>(f);
+    ASSERT_TRUE(f.isFinished());
+    ASSERT_TRUE(f.isCanceled());
+}
+
 #include "Test_Futures_5_SignalToFuture.moc"
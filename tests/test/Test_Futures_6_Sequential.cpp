@@ -6,6 +6,10 @@
 
 #include <atomic>
 #include <chrono>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
 
 #include <QtConcurrent/QtConcurrent>
 #include <QEventLoop>
@@ -1122,3 +1126,235 @@ TEST(UtilsQt, Futures_Sequential_Awaitable)
         ASSERT_EQ(f.resultCount(), 0);
     }
 }
+
+TEST(UtilsQt, Futures_Sequential_ManyCancellationSubscriptions)
+{
+    using namespace std::chrono_literals;
+
+    constexpr int ThreadsCount = 4;
+    constexpr int SubscriptionsPerThread = 16;
+
+    QObject obj;
+    std::vector<std::thread> threads;
+    std::atomic<int> subscribed {0};
+    std::atomic<int> notified {0};
+
+    auto f = UtilsQt::Sequential(&obj)
+                 .start([&threads, &subscribed, &notified](UtilsQt::SequentialMediator& sm) {
+                     UtilsQt::Promise<int> promise(true);
+
+                     for (int t = 0; t < ThreadsCount; t++) {
+                         threads.emplace_back([&subscribed, &notified, sm, promise]() mutable {
+                             using Subscription = decltype(sm.onCancellation({}));
+                             std::vector<std::unique_ptr<Subscription>> subscriptions;
+
+                             for (int i = 0; i < SubscriptionsPerThread; i++)
+                                 subscriptions.emplace_back(new Subscription(sm.onCancellation([&notified](){ notified++; })));
+
+                             subscribed++;
+
+                             while (!sm.isCancelRequested())
+                                 std::this_thread::sleep_for(5ms);
+                         });
+                     }
+
+                     return promise.future();
+                 })
+                 .execute();
+
+    ASSERT_TRUE(TestHelpers::waitForCounter(subscribed, ThreadsCount));
+    f.cancel();
+    UtilsQt::waitForFuture<QEventLoop>(f);
+    ASSERT_TRUE(f.isCanceled());
+
+    for (auto& x : threads)
+        x.join();
+
+    ASSERT_EQ(notified.load(), ThreadsCount * SubscriptionsPerThread);
+}
+
+TEST(UtilsQt, Futures_Sequential_ThenAll)
+{
+    using Joined = std::tuple<UtilsQt::AsyncResult<int>, UtilsQt::AsyncResult<QString>, UtilsQt::AsyncResult<void>>;
+
+    QObject obj;
+    auto f = UtilsQt::Sequential(&obj)
+                 .start([](){ return UtilsQt::createReadyFuture(10); })
+                 .thenAll([](const UtilsQt::AsyncResult<int>& r){ return UtilsQt::createTimedFuture(30, r.value() + 1); },
+                          [](const UtilsQt::AsyncResult<int>& r, const UtilsQt::SequentialMediator&){ return UtilsQt::createTimedFuture(10, QString::number(r.value())); },
+                          [](const UtilsQt::AsyncResult<int>&) -> QFuture<void> { throw MyException(); })
+                 .then([](const UtilsQt::AsyncResult<Joined>& r){
+                     r.tryRethrow();
+                     const auto& [a, b, c] = r.value();
+                     return UtilsQt::createReadyFuture(QString("%1 %2 %3").arg(a.value()).arg(b.value()).arg(c.hasException() ? 1 : 0));
+                 })
+                 .execute();
+
+    UtilsQt::waitForFuture<QEventLoop>(f);
+    ASSERT_TRUE(f.isFinished());
+    ASSERT_FALSE(f.isCanceled());
+    ASSERT_EQ(f.result(), QString("11 10 1"));
+}
+
+TEST(UtilsQt, Futures_Sequential_ThenEach)
+{
+    const QVector<int> items {1, 2, 3, 4};
+
+    QObject obj;
+    auto f = UtilsQt::Sequential(&obj)
+                 .start([](){ return UtilsQt::createReadyFuture(100); })
+                 .thenEach(items, [](int x, const UtilsQt::AsyncResult<int>& r){
+                     return x == 3 ? UtilsQt::createTimedCanceledFuture<int>(10) :
+                                     UtilsQt::createTimedFuture(40 - x * 10, r.value() + x);
+                 })
+                 .then([](const UtilsQt::AsyncResult<QVector<UtilsQt::AsyncResult<int>>>& r){
+                     r.tryRethrow();
+
+                     QVector<int> result;
+                     for (const auto& x : r.value())
+                         result.append(x.valueOr(-1));
+
+                     return UtilsQt::createReadyFuture(result);
+                 })
+                 .execute();
+
+    UtilsQt::waitForFuture<QEventLoop>(f);
+    ASSERT_TRUE(f.isFinished());
+    ASSERT_FALSE(f.isCanceled());
+    ASSERT_EQ(f.result(), (QVector<int> {101, 102, -1, 104}));
+}
+
+TEST(UtilsQt, Futures_Sequential_ThenEach_Empty)
+{
+    QObject obj;
+    auto f = UtilsQt::Sequential(&obj)
+                 .start([](){ return UtilsQt::createReadyFuture(100); })
+                 .thenEach(QVector<int>(), [](int x, const UtilsQt::AsyncResult<int>&){ return UtilsQt::createReadyFuture(x); })
+                 .then([](const UtilsQt::AsyncResult<QVector<UtilsQt::AsyncResult<int>>>& r){
+                     r.tryRethrow();
+                     return UtilsQt::createReadyFuture(r.value().size());
+                 })
+                 .execute();
+
+    UtilsQt::waitForFuture<QEventLoop>(f);
+    ASSERT_TRUE(f.isFinished());
+    ASSERT_FALSE(f.isCanceled());
+    ASSERT_EQ(f.result(), 0);
+}
+
+TEST(UtilsQt, Futures_Sequential_ThenAll_Cancellation)
+{
+    using Joined = std::tuple<UtilsQt::AsyncResult<int>, UtilsQt::AsyncResult<int>>;
+
+    QObject obj;
+    UtilsQt::Promise<int> p1(true);
+    UtilsQt::Promise<int> p2(true);
+    std::optional<UtilsQt::SequentialMediator> branchMediator;
+    bool nextCalled {false};
+
+    auto f = UtilsQt::Sequential(&obj)
+                 .start([](){ return UtilsQt::createReadyFuture(1); })
+                 .thenAll([p1](const UtilsQt::AsyncResult<int>&){ return p1.future(); },
+                          [p2, &branchMediator](const UtilsQt::AsyncResult<int>&, const UtilsQt::SequentialMediator& sm){
+                              branchMediator = sm;
+                              return p2.future();
+                          })
+                 .then([&nextCalled](const UtilsQt::AsyncResult<Joined>&){
+                     nextCalled = true;
+                     return UtilsQt::createReadyFuture();
+                 })
+                 .execute();
+
+    ASSERT_TRUE(branchMediator);
+    ASSERT_FALSE(branchMediator->isCancelRequested());
+
+    f.cancel();
+    UtilsQt::waitForFuture<QEventLoop>(f);
+    ASSERT_TRUE(f.isCanceled());
+
+    ASSERT_TRUE(TestHelpers::waitUntil([&](){ return p1.future().isCanceled() && p2.future().isCanceled(); }));
+    ASSERT_TRUE(branchMediator->isCancelRequested());
+    ASSERT_FALSE(nextCalled);
+}
+
+TEST(UtilsQt, Futures_Sequential_Awaitables_WaitForAndPending)
+{
+    QObject obj;
+    UtilsQt::Awaitables awaitables;
+    std::atomic<bool> release {false};
+
+    auto f = UtilsQt::Sequential(&obj)
+        .start([&release](UtilsQt::SequentialMediator& sm) {
+            auto fThr = QtConcurrent::run([&release]() {
+                while (!release.load(std::memory_order_acquire))
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            });
+
+            sm.registerAwaitable(fThr, "worker");
+
+            for (int i = 0; i < 100; i++)
+                sm.registerAwaitable(UtilsQt::createReadyFuture());
+
+            return UtilsQt::createReadyFuture(1);
+        })
+        .execute(awaitables);
+
+    UtilsQt::waitForFuture<QEventLoop>(f);
+
+    const auto pending = awaitables.pending();
+    ASSERT_EQ(pending.size(), 1);
+    ASSERT_EQ(pending.first().description, "worker");
+    ASSERT_TRUE(awaitables.isRunning());
+
+    // Total timeout
+    ASSERT_FALSE(awaitables.waitFor(std::chrono::milliseconds(50)));
+    ASSERT_EQ(awaitables.pending().size(), 1);
+    ASSERT_GE(awaitables.pending().first().age.count(), 50);
+
+    release = true;
+    ASSERT_TRUE(awaitables.waitFor(std::chrono::milliseconds(TestHelpers::SafetyTimeoutMs)));
+    ASSERT_FALSE(awaitables.isRunning());
+    ASSERT_TRUE(awaitables.pending().isEmpty());
+}
+
+TEST(UtilsQt, Futures_Sequential_Awaitables_WaitFor_Waiter)
+{
+    QObject obj;
+    UtilsQt::Awaitables awaitables;
+    bool released {false};
+    int expectantCalls {0};
+    int waiterCalls {0};
+
+    auto f = UtilsQt::Sequential(&obj)
+        .start([&](UtilsQt::SequentialMediator& sm) {
+            UtilsQt::SequentialMediator::AwaitableData data;
+            data.expectant = [&expectantCalls]() { expectantCalls++; };
+            data.description = "custom";
+            data.waiter = [&](std::chrono::steady_clock::time_point deadline) {
+                waiterCalls++;
+                while (!released && std::chrono::steady_clock::now() < deadline)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                return released;
+            };
+            sm.registerAwaitable(data);
+
+            return UtilsQt::createReadyFuture(1);
+        })
+        .execute(awaitables);
+
+    UtilsQt::waitForFuture<QEventLoop>(f);
+
+    // Deadline is passed to waiter, expectant isn't called; nothing runs after return
+    const auto started = std::chrono::steady_clock::now();
+    ASSERT_FALSE(awaitables.waitFor(std::chrono::milliseconds(50)));
+    ASSERT_GE(std::chrono::steady_clock::now() - started, std::chrono::milliseconds(50));
+    ASSERT_EQ(waiterCalls, 1);
+    ASSERT_EQ(expectantCalls, 0);
+    ASSERT_EQ(awaitables.pending().size(), 1);
+
+    released = true;
+    ASSERT_TRUE(awaitables.waitFor(std::chrono::milliseconds(TestHelpers::SafetyTimeoutMs)));
+    ASSERT_EQ(waiterCalls, 2);
+    ASSERT_EQ(expectantCalls, 0);
+    ASSERT_TRUE(awaitables.pending().isEmpty());
+}
@@ -0,0 +1,142 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/utils-qt
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <gtest/gtest.h>
+#include <UtilsQt/Futures/Coroutine.h>
+
+#ifdef UTILS_QT_HAS_COROUTINES
+#include <memory>
+#include <UtilsQt/Futures/Utils.h>
+#include <QEventLoop>
+#include <QString>
+
+namespace {
+
+class MyException : public std::exception { };
+
+QFuture<QString> sumAsString(QObject* /*context*/, QFuture<int> a, QFuture<int> b)
+{
+    const int x = co_await a;
+    const int y = co_await b;
+    co_return QString::number(x + y);
+}
+
+QFuture<void> awaitAndThrow(QObject* /*context*/)
+{
+    co_await UtilsQt::createTimedFuture(10);
+    throw MyException();
+}
+
+QFuture<int> awaitCanceled(QObject* /*context*/, bool* reachedEnd)
+{
+    const int x = co_await UtilsQt::createTimedCanceledFuture<int>(10);
+    *reachedEnd = true;
+    co_return x;
+}
+
+QFuture<bool> awaitAsAsyncResult(QObject* /*context*/)
+{
+    const auto r = co_await UtilsQt::asAsyncResult(UtilsQt::createTimedCanceledFuture<int>(10));
+    co_return r.isCanceled();
+}
+
+QFuture<int> awaitPromise(QObject* /*context*/, QFuture<int> f, bool* reachedEnd)
+{
+    const int x = co_await f;
+    *reachedEnd = true;
+    co_return x;
+}
+
+} // namespace
+
+TEST(UtilsQt, Futures_Coroutine_Basic)
+{
+    QObject ctx;
+    auto f = sumAsString(&ctx, UtilsQt::createReadyFuture(1), UtilsQt::createTimedFuture(20, 2));
+
+    UtilsQt::waitForFuture<QEventLoop>(f);
+    ASSERT_TRUE(f.isFinished());
+    ASSERT_FALSE(f.isCanceled());
+    ASSERT_EQ(f.result(), QString("3"));
+}
+
+TEST(UtilsQt, Futures_Coroutine_Exception)
+{
+    QObject ctx;
+    auto f = awaitAndThrow(&ctx);
+
+    UtilsQt::waitForFuture<QEventLoop>(f);
+    ASSERT_EQ(UtilsQt::getFutureState(f), UtilsQt::FutureState::Exception);
+    ASSERT_THROW(f.waitForFinished(), MyException);
+}
+
+TEST(UtilsQt, Futures_Coroutine_AwaitedCanceled)
+{
+    QObject ctx;
+    bool reachedEnd {false};
+    auto f = awaitCanceled(&ctx, &reachedEnd);
+
+    UtilsQt::waitForFuture<QEventLoop>(f);
+    ASSERT_TRUE(f.isCanceled());
+    ASSERT_FALSE(reachedEnd);
+}
+
+TEST(UtilsQt, Futures_Coroutine_AsAsyncResult)
+{
+    QObject ctx;
+    auto f = awaitAsAsyncResult(&ctx);
+
+    UtilsQt::waitForFuture<QEventLoop>(f);
+    ASSERT_FALSE(f.isCanceled());
+    ASSERT_TRUE(f.result());
+}
+
+TEST(UtilsQt, Futures_Coroutine_ResultCanceled)
+{
+    QObject ctx;
+    UtilsQt::Promise<int> promise(true);
+    bool reachedEnd {false};
+    auto f = awaitPromise(&ctx, promise.future(), &reachedEnd);
+
+    f.cancel();
+    UtilsQt::waitForFuture<QEventLoop>(f);
+    ASSERT_TRUE(f.isCanceled());
+    ASSERT_TRUE(promise.isCanceled());
+    ASSERT_FALSE(reachedEnd);
+}
+
+TEST(UtilsQt, Futures_Coroutine_ContextDestroyed)
+{
+    auto ctx = std::make_unique<QObject>();
+    UtilsQt::Promise<int> promise(true);
+    bool reachedEnd {false};
+    auto f = awaitPromise(ctx.get(), promise.future(), &reachedEnd);
+
+    ctx.reset();
+    UtilsQt::waitForFuture<QEventLoop>(f);
+    ASSERT_TRUE(f.isCanceled());
+    ASSERT_FALSE(reachedEnd);
+}
+
+TEST(UtilsQt, Futures_Coroutine_SameFutureTwice)
+{
+    QObject ctx;
+    UtilsQt::Promise<int> promise(true);
+    bool reachedEnd1 {false};
+    bool reachedEnd2 {false};
+    auto f1 = awaitPromise(&ctx, promise.future(), &reachedEnd1);
+    auto f2 = awaitPromise(&ctx, promise.future(), &reachedEnd2);
+
+    promise.finish(5);
+    UtilsQt::waitForFuture<QEventLoop>(f1);
+    UtilsQt::waitForFuture<QEventLoop>(f2);
+    ASSERT_TRUE(reachedEnd1);
+    ASSERT_TRUE(reachedEnd2);
+    ASSERT_EQ(f1.result(), 5);
+    ASSERT_EQ(f2.result(), 5);
+}
+
+#elif defined(UTILS_QT_EXPECT_COROUTINES)
+#error "Coroutine tests are built with C++20, but coroutines support isn't detected"
+#endif // UTILS_QT_HAS_COROUTINES
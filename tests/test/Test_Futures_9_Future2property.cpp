@@ -0,0 +1,151 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/utils-qt
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <gtest/gtest.h>
+#include <UtilsQt/Futures/future2property.h>
+#include <UtilsQt/Futures/Utils.h>
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QVector>
+#include <memory>
+
+#include "internal/TestWaitHelpers.h"
+
+using namespace UtilsQt;
+
+TEST(UtilsQt, Futures_Future2propertyBinding_LatestWins)
+{
+    QObject ctx;
+    QVector<Promise<int>> requests;
+    QVector<int> values;
+    int errors = 0;
+
+    auto binding = future2propertyBinding(&ctx,
+                                          [&](){ requests.append(Promise<int>(true)); return requests.last().future(); },
+                                          [&](int value){ values.append(value); },
+                                          [&](){ errors++; });
+
+    binding->trigger();
+    binding->trigger();
+    ASSERT_EQ(requests.size(), 2);
+    ASSERT_TRUE(requests[0].isCanceled()); // Superseded
+    ASSERT_TRUE(binding->isInFlight());
+
+    requests[1].finish(2);
+    ASSERT_TRUE(TestHelpers::waitUntil([&](){ return !values.isEmpty(); }));
+    ASSERT_EQ(values, QVector<int>({2}));
+    ASSERT_FALSE(binding->isInFlight());
+    ASSERT_EQ(errors, 0);
+
+    const auto& metrics = binding->metrics();
+    ASSERT_EQ(metrics.requests, 2u);
+    ASSERT_EQ(metrics.applied, 1u);
+    ASSERT_EQ(metrics.superseded, 1u);
+    ASSERT_EQ(metrics.failed, 0u);
+}
+
+TEST(UtilsQt, Futures_Future2propertyBinding_LatestWins_ReadyFutures)
+{
+    QObject ctx;
+    int calls = 0;
+    QVector<int> values;
+    int errors = 0;
+
+    auto binding = future2propertyBinding(&ctx,
+                                          [&](){ return createReadyFuture(++calls); },
+                                          [&](int value){ values.append(value); },
+                                          [&](){ errors++; },
+                                          3, 2000, 0);
+
+    // Notifications of replaced futures are already posted, they must not be taken for the latest one
+    for (int i = 0; i < 10; i++)
+        binding->trigger();
+
+    ASSERT_TRUE(TestHelpers::waitUntil([&](){ return !values.isEmpty(); }));
+    TestHelpers::waitMs(50);
+
+    ASSERT_EQ(values, QVector<int>({10}));
+    ASSERT_EQ(calls, 10); // No retries
+    ASSERT_EQ(errors, 0);
+
+    const auto& metrics = binding->metrics();
+    ASSERT_EQ(metrics.requests, 10u);
+    ASSERT_EQ(metrics.applied, 1u);
+    ASSERT_EQ(metrics.superseded, 9u);
+    ASSERT_EQ(metrics.failed, 0u);
+}
+
+TEST(UtilsQt, Futures_Future2propertyBinding_Debounce)
+{
+    QObject ctx;
+    int calls = 0;
+    int lastValue = -1;
+
+    auto binding = future2propertyBinding(&ctx,
+                                          [&](){ return createReadyFuture(++calls); },
+                                          [&](int value){ lastValue = value; },
+                                          [](){});
+    binding->setPacing(Future2propertyPacing::Debounce, 50);
+
+    for (int i = 0; i < 10; i++)
+        binding->trigger();
+
+    ASSERT_EQ(calls, 0);
+    ASSERT_TRUE(TestHelpers::waitUntil([&](){ return lastValue == 1; }));
+    TestHelpers::waitMs(100);
+    ASSERT_EQ(calls, 1);
+}
+
+TEST(UtilsQt, Futures_Future2propertyBinding_Throttle)
+{
+    QObject ctx;
+    int calls = 0;
+
+    auto binding = future2propertyBinding(&ctx,
+                                          [&](){ return createReadyFuture(++calls); },
+                                          [](int){},
+                                          [](){});
+    binding->setPacing(Future2propertyPacing::Throttle, 50);
+
+    for (int i = 0; i < 10; i++)
+        binding->trigger();
+
+    ASSERT_EQ(calls, 1); // Leading
+    ASSERT_TRUE(TestHelpers::waitUntil([&](){ return calls == 2; })); // Trailing
+    TestHelpers::waitMs(100);
+    ASSERT_EQ(calls, 2);
+}
+
+TEST(UtilsQt, Futures_Future2propertyBinding_RetryAndError)
+{
+    QObject ctx;
+    int calls = 0;
+    int errors = 0;
+
+    auto binding = future2propertyBinding(&ctx,
+                                          [&](){ calls++; return createCanceledFuture<int>(); },
+                                          [](int){},
+                                          [&](){ errors++; },
+                                          2, 1000, 10);
+    binding->trigger();
+
+    ASSERT_TRUE(TestHelpers::waitUntil([&](){ return errors == 1; }));
+    ASSERT_EQ(calls, 3);
+    ASSERT_EQ(binding->metrics().failed, 1u);
+}
+
+TEST(UtilsQt, Futures_Future2propertyBinding_ContextDestroyed)
+{
+    Promise<int> promise(true);
+    auto ctx = std::make_unique<QObject>();
+
+    auto binding = future2propertyBinding(ctx.get(),
+                                          [&](){ return promise.future(); },
+                                          [](int){},
+                                          [](){});
+    binding->trigger();
+    ctx.reset();
+
+    ASSERT_TRUE(promise.isCanceled());
+}
@@ -8,6 +8,8 @@
 #include <QTimer>
 #include <QElapsedTimer>
 #include <QEventLoop>
+#include <QThread>
+#include <memory>
 
 #include "internal/TestWaitHelpers.h"
 
@@ -300,4 +302,101 @@ TEST(UtilsQt, onProperty_flexible_signal)
     ASSERT_EQ(testObject.counter(), expected);
 }
 
+TEST(UtilsQt, onProperty_shared)
+{
+    QObject context;
+    TestObject testObject;
+    int triggeredCount = 0;
+    int cancelledCount = 0;
+
+    // Already matches
+    onPropertyShared(&testObject, &TestObject::counter, &TestObject::counterChanged, 0, UtilsQt::Comparison::Equal, &context,
+                     [&](){ triggeredCount++; });
+    ASSERT_EQ(triggeredCount, 1);
+
+    for (int i = 0; i < 100; i++) {
+        onPropertyShared(&testObject, &TestObject::counter, &TestObject::counterChanged, 1 + i % 3, UtilsQt::Comparison::Equal, &context,
+                         [&](){ triggeredCount++; },
+                         -1,
+                         [&](auto){ cancelledCount++; });
+    }
+
+    auto f = onPropertyFutureShared(&testObject, &TestObject::counter, &TestObject::counterChanged2, 2, UtilsQt::Comparison::Equal, &context);
+
+    // Single multiplexer per (object, getter, notifier)
+    ASSERT_EQ(testObject.children().size(), 2);
+
+    ASSERT_TRUE(TestHelpers::waitUntil([&]{ return triggeredCount == 101; }));
+    waitForFuture<QEventLoop>(f);
+    ASSERT_FALSE(f.isCanceled());
+    ASSERT_EQ(cancelledCount, 0);
+    ASSERT_EQ(testObject.children().size(), 2); // Multiplexers are reused
+}
+
+TEST(UtilsQt, onProperty_shared_cancelled)
+{
+    // Timeout
+    {
+        QObject context;
+        TestObject testObject;
+        testObject.stop();
+
+        QElapsedTimer elapsedTimer;
+        elapsedTimer.start();
+        auto f = onPropertyFutureShared(&testObject, &TestObject::counter, &TestObject::counterChanged, 1, UtilsQt::Comparison::Equal, &context, 100);
+        auto f2 = onPropertyFutureShared(&testObject, &TestObject::counter, &TestObject::counterChanged, 1, UtilsQt::Comparison::Equal, &context);
+
+        waitForFuture<QEventLoop>(f);
+        ASSERT_TRUE(f.isCanceled());
+        ASSERT_GE(elapsedTimer.elapsed(), 100);
+        ASSERT_FALSE(f2.isFinished());
+    }
+
+    // Context
+    {
+        auto context = std::make_unique<QObject>();
+        TestObject testObject;
+        UtilsQt::CancelReason reason = UtilsQt::CancelReason::Unknown;
+
+        onPropertyShared(&testObject, &TestObject::counter, &TestObject::counterChanged, 100, UtilsQt::Comparison::Equal, context.get(),
+                         [](){}, -1, [&](UtilsQt::CancelReason value){ reason = value; });
+        context.reset();
+        ASSERT_EQ(reason, UtilsQt::CancelReason::Context);
+    }
+
+    // Object
+    {
+        QObject context;
+        auto testObject = std::make_unique<TestObject>();
+        UtilsQt::CancelReason reason = UtilsQt::CancelReason::Unknown;
+
+        onPropertyShared(testObject.get(), &TestObject::counter, &TestObject::counterChanged, 100, UtilsQt::Comparison::Equal, &context,
+                         [](){}, 1000, [&](UtilsQt::CancelReason value){ reason = value; });
+        testObject.reset();
+        ASSERT_EQ(reason, UtilsQt::CancelReason::Object);
+    }
+}
+
+TEST(UtilsQt, onProperty_shared_movedToThread)
+{
+    auto testObject = new TestObject();
+    testObject->stop();
+    UtilsQt::CancelReason reason = UtilsQt::CancelReason::Unknown;
+
+    onPropertyShared(testObject, &TestObject::counter, &TestObject::counterChanged, 100, UtilsQt::Comparison::Equal, nullptr,
+                     [](){}, -1, [&](UtilsQt::CancelReason value){ reason = value; });
+    ASSERT_EQ(OnPropertyInternal::MultiplexerBase::multiplexersOf(testObject).size(), 1);
+
+    // Multiplexer is destroyed with the object in another thread, than where it was registered
+    QThread thread;
+    thread.start();
+    testObject->moveToThread(&thread);
+    QMetaObject::invokeMethod(testObject, [testObject](){ delete testObject; }, Qt::BlockingQueuedConnection);
+    thread.quit();
+    thread.wait();
+
+    ASSERT_EQ(reason, UtilsQt::CancelReason::Object);
+    ASSERT_TRUE(OnPropertyInternal::MultiplexerBase::multiplexersOf(testObject).empty());
+}
+
 #include "test03_onProperty.moc"
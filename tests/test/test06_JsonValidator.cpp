@@ -10,6 +10,9 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QList>
+#include <QBuffer>
+#include <QTemporaryFile>
+#include <stdexcept>
 
 TEST(UtilsQt, JsonValidator_basic)
 {
@@ -652,3 +655,410 @@ TEST(UtilsQt, JsonValidator_CustomValidator)
     ASSERT_FALSE(rsl);
     ASSERT_TRUE(lg.hasError());
 }
+
+
+TEST(UtilsQt, JsonValidator_ErrorPath)
+{
+    using namespace UtilsQt::JsonValidator;
+
+    auto validator =
+        RootValidator(
+          Object(
+            Field("items", Array(
+              Object(
+                Field("name", String()),
+                Field("values", Array(Number()))
+              )
+            ))
+          )
+        );
+
+    const auto doc = QJsonDocument::fromJson(R"({"items": [{"name": "a", "values": [1, 2]},
+                                                           {"name": "b", "values": [3, "x"]}]})");
+
+    ErrorInfo lg;
+    ASSERT_FALSE(validator->check(lg, doc.object()));
+    ASSERT_EQ(lg.getErrorPath(), "/items[1]/values[1]");
+
+    lg.clear();
+    ASSERT_FALSE(validator->check(lg, QJsonArray()));
+    ASSERT_EQ(lg.getErrorPath(), "/");
+
+    lg.clear();
+    ASSERT_FALSE(validator->check(lg, QJsonDocument::fromJson(R"({"items": [{"values": []}]})").object()));
+    ASSERT_EQ(lg.getErrorPath(), "/items[0]");
+
+    Path path;
+    ASSERT_TRUE(path.isEmpty());
+    const QString key = "key";
+    path.pushKey(key);
+    path.pushIndex(5);
+    path.setIndex(7);
+    ASSERT_EQ(path.toString(), "/key[7]");
+    path.pop();
+    path.pop();
+    ASSERT_TRUE(path.isEmpty());
+}
+
+
+TEST(UtilsQt, JsonValidator_Compiled)
+{
+    using namespace UtilsQt::JsonValidator;
+
+    auto validator =
+        RootValidator(
+          Object(
+            Field("id", Number(Integer, {0}, {})),
+            Field("name", String(NonEmpty)),
+            Field("kind", String(Include("a", "b"))),
+            Field("value", Or(String(), Number(), Object(Field("x", Bool())))),
+            Field("single", Optional, Or(Exclusive, Number(), Number({0}, {10}), String())),
+            Field("items", Optional, Array(
+              And(Object(
+                Field("key", String()),
+                Field("ref", Optional, CtxCheckInList("keys"))
+              ),
+              Field("key", CtxAppendToList("keys")))
+            )),
+            Field("sizes", Optional, Array(Number()), ArrayLength({1}, {3}))
+          ),
+          CtxClearRecord("keys")
+        );
+
+    const auto compiled = Compile(validator);
+    ASSERT_GT(compiled->instructionsCount(), 10u);
+
+    const QStringList documents {
+        R"({"id": 1, "name": "n", "kind": "a", "value": "str"})",
+        R"({"id": 1, "name": "n", "kind": "a", "value": 5})",
+        R"({"id": 1, "name": "n", "kind": "a", "value": {"x": true}})",
+        R"({"id": 1, "name": "n", "kind": "a", "value": {"x": 1}})",
+        R"({"id": 1, "name": "n", "kind": "a", "value": true})",
+        R"({"id": 1, "name": "n", "kind": "a", "value": null})",
+        R"({"id": 1, "name": "n", "kind": "c", "value": ""})",
+        R"({"id": -1, "name": "n", "kind": "a", "value": ""})",
+        R"({"id": 1.5, "name": "n", "kind": "a", "value": ""})",
+        R"({"id": 1, "name": "", "kind": "a", "value": ""})",
+        R"({"id": 1, "kind": "a", "value": ""})",
+        R"({"id": 1, "name": "n", "kind": "a", "value": "", "single": "s"})",
+        R"({"id": 1, "name": "n", "kind": "a", "value": "", "single": 5})",
+        R"({"id": 1, "name": "n", "kind": "a", "value": "", "single": 50})",
+        R"({"id": 1, "name": "n", "kind": "a", "value": "", "single": false})",
+        R"({"id": 1, "name": "n", "kind": "a", "value": "", "items": [{"key": "k1"}, {"key": "k2", "ref": "k1"}]})",
+        R"({"id": 1, "name": "n", "kind": "a", "value": "", "items": [{"key": "k1"}, {"key": "k2", "ref": "k3"}]})",
+        R"({"id": 1, "name": "n", "kind": "a", "value": "", "items": [{"key": "k1"}, 5]})",
+        R"({"id": 1, "name": "n", "kind": "a", "value": "", "items": {}})",
+        R"({"id": 1, "name": "n", "kind": "a", "value": "", "sizes": [1, 2]})",
+        R"({"id": 1, "name": "n", "kind": "a", "value": "", "sizes": []})",
+        R"({"id": 1, "name": "n", "kind": "a", "value": "", "sizes": [1, "2"]})",
+    };
+
+    QList<QJsonValue> values {QJsonArray(), QJsonValue("string")};
+    for (const auto& x : documents)
+        values.append(QJsonDocument::fromJson(x.toUtf8()).object());
+
+    for (const auto& value : values) {
+        const auto description = QJsonDocument(QJsonArray{value}).toJson(QJsonDocument::Compact).toStdString();
+
+        ErrorInfo expected;
+        ErrorInfo actual;
+        ContextData expectedCtx;
+        ContextData actualCtx;
+        Path path;
+
+        ASSERT_EQ(compiled->check(actualCtx, actual, value), validator->check(expectedCtx, expected, path, value)) << description;
+        ASSERT_EQ(actual.hasError(), expected.hasError()) << description;
+        ASSERT_EQ(actual.getErrorPath(), expected.getErrorPath()) << description;
+        ASSERT_EQ(actual.getErrorDescription(), expected.getErrorDescription()) << description;
+        ASSERT_EQ(actualCtx, expectedCtx) << description;
+    }
+}
+
+
+TEST(UtilsQt, JsonValidator_HashedLists)
+{
+    using namespace UtilsQt::JsonValidator;
+
+    // Include / Exclude
+    auto validator = RootValidator(Include(1, 0.0, "a", true, QJsonValue()));
+    ErrorInfo lg;
+
+    for (const auto& x : {QJsonValue(1), QJsonValue(1.0), QJsonValue(-0.0), QJsonValue("a"), QJsonValue(true), QJsonValue()})
+        ASSERT_TRUE(validator->check(lg, x));
+
+    for (const auto& x : {QJsonValue(2), QJsonValue("b"), QJsonValue(false), QJsonValue("1"), QJsonValue(QJsonArray())})
+        ASSERT_FALSE(validator->check(lg, x));
+
+    validator = RootValidator(Exclude(1, "a"));
+    ASSERT_FALSE(validator->check(lg, 1.0));
+    ASSERT_FALSE(validator->check(lg, "a"));
+    ASSERT_TRUE(validator->check(lg, 2));
+
+    // Context lists: many references are checked against many keys
+    validator =
+        RootValidator(
+          Object(
+            Field("keys", Array(CtxAppendToList("keys"))),
+            Field("refs", Array(CtxCheckInList("keys"))),
+            Field("other", Array(CtxCheckNotInList("keys")))
+          )
+        );
+
+    QJsonArray keys;
+    QJsonArray refs;
+    QJsonArray other;
+
+    for (int i = 0; i < 10000; i++) {
+        keys.append(QString("key-%1").arg(i));
+        refs.append(QString("key-%1").arg(9999 - i));
+        other.append(i);
+    }
+
+    QJsonObject obj {{"keys", keys}, {"refs", refs}, {"other", other}};
+    ContextData ctx;
+    Path path;
+    ASSERT_TRUE(validator->check(ctx, lg, path, obj));
+    ASSERT_EQ(ctx.value("keys").toList().size(), 10000);
+
+    refs.append("missing");
+    obj["refs"] = refs;
+    ctx = ContextData();
+    ASSERT_FALSE(validator->check(ctx, lg, path, obj));
+
+    // Lists provided by caller or replaced between checks
+    validator = RootValidator(Array(CtxCheckInList("allowed")));
+    ctx = ContextData();
+    ctx["allowed"] = QVariantList{"x", "y"};
+    ASSERT_TRUE(validator->check(ctx, lg, path, QJsonArray{"x", "y"}));
+    ASSERT_FALSE(validator->check(ctx, lg, path, QJsonArray{"z"}));
+
+    ctx["allowed"] = QVariantList{"z"};
+    ASSERT_TRUE(validator->check(ctx, lg, path, QJsonArray{"z"}));
+    ASSERT_FALSE(validator->check(ctx, lg, path, QJsonArray{"x"}));
+
+    // QVariantMap::clear / remove aren't virtual and don't drop the index, new list of the same size
+    // can't be taken for the indexed one
+    for (int i = 0; i < 100; i++) {
+        ctx.clear();
+        ctx["allowed"] = QVariantList{QString("a%1").arg(i)};
+        ASSERT_TRUE(validator->check(ctx, lg, path, QJsonArray{QString("a%1").arg(i)}));
+
+        ctx.remove("allowed");
+        ctx["allowed"] = QVariantList{QString("b%1").arg(i)};
+        ASSERT_FALSE(validator->check(ctx, lg, path, QJsonArray{QString("a%1").arg(i)}));
+    }
+}
+
+
+TEST(UtilsQt, JsonValidator_CompiledParallel)
+{
+    using namespace UtilsQt::JsonValidator;
+
+    auto validator =
+        RootValidator(
+          Object(
+            Field("items", Array(
+              Object(
+                Field("id", Number(Integer, {0}, {})),
+                Field("tags", Array(String()))
+              )
+            )),
+            Field("keys", Optional, Array(CtxAppendToList("keys")))
+          )
+        );
+
+    const auto compiled = Compile(validator);
+
+    ParallelOptions parallel;
+    parallel.enabled = true;
+    parallel.minArraySize = 16;
+    parallel.chunkSize = 7;
+
+    QJsonArray items;
+    QJsonArray keys;
+
+    for (int i = 0; i < 1000; i++) {
+        items.append(QJsonObject{{"id", i}, {"tags", QJsonArray{"a", "b"}}});
+        keys.append(QString("key-%1").arg(i));
+    }
+
+    auto check = [&](const QJsonObject& obj) {
+        ErrorInfo expected;
+        ErrorInfo actual;
+        ContextData expectedCtx;
+        ContextData actualCtx;
+
+        const auto result = compiled->check(actualCtx, actual, obj, parallel);
+        EXPECT_EQ(result, compiled->check(expectedCtx, expected, obj));
+        EXPECT_EQ(actual.getErrorPath(), expected.getErrorPath());
+        EXPECT_EQ(actual.getErrorDescription(), expected.getErrorDescription());
+        EXPECT_EQ(actualCtx, expectedCtx);
+        return actual;
+    };
+
+    // Valid; Ctx* array is validated sequentially
+    QJsonObject obj {{"items", items}, {"keys", keys}};
+    ASSERT_FALSE(check(obj).hasError());
+
+    // Several errors: the first one in document order is reported
+    items[900] = QJsonObject{{"id", -1}, {"tags", QJsonArray{}}};
+    items[500] = QJsonObject{{"id", 5}, {"tags", QJsonArray{"a", 1}}};
+    items[501] = 5;
+    obj["items"] = items;
+    ASSERT_EQ(check(obj).getErrorPath(), "/items[500]/tags[1]");
+
+    items[3] = QJsonObject{{"tags", QJsonArray{}}};
+    obj["items"] = items;
+    ASSERT_EQ(check(obj).getErrorPath(), "/items[3]");
+
+    // Logger receives the error
+    LoggedErrorInfo logged;
+    ASSERT_FALSE(compiled->check(logged, obj, parallel));
+    ASSERT_EQ(logged.getErrorPath(), "/items[3]");
+}
+
+
+TEST(UtilsQt, JsonValidator_CompiledParallel_Throws)
+{
+    using namespace UtilsQt::JsonValidator;
+
+    auto validator =
+        RootValidator(
+          Array(CustomValidator([](const QJsonValue& val) {
+              if (val.toInt() == 500)
+                  throw std::runtime_error("Custom validator failure");
+              return true;
+          }))
+        );
+
+    const auto compiled = Compile(validator);
+
+    ParallelOptions parallel;
+    parallel.enabled = true;
+    parallel.minArraySize = 16;
+    parallel.chunkSize = 7;
+
+    QJsonArray items;
+    for (int i = 0; i < 1000; i++)
+        items.append(i);
+
+    // Exception from a chunk reaches the caller, as in sequential mode
+    ErrorInfo lg;
+    ASSERT_THROW(compiled->check(lg, items, parallel), std::runtime_error);
+    ASSERT_THROW(compiled->check(lg, items), std::runtime_error);
+}
+
+
+TEST(UtilsQt, JsonValidator_Stream)
+{
+    using namespace UtilsQt::JsonValidator;
+
+    auto validator =
+        RootValidator(
+          Object(
+            Field("keys", Array(CtxAppendToList("keys")), CtxWriteArrayLength("keysCount")),
+            Field("items", Array(
+              Object(
+                Field("id", Number(Integer, {0}, {})),
+                Field("name", String(NonEmpty)),
+                Field("ref", Optional, CtxCheckInList("keys")),
+                Field("value", Optional, Or(Number(), Object(Field("x", Bool()))))
+              )
+            ), ArrayLength({1}, {})),
+            Field("sizes", Optional, Array(Number()), CtxCheckArrayLength("keysCount"))
+          ),
+          CtxClearRecord("keys")
+        );
+
+    const auto compiled = Compile(validator);
+
+    const QStringList documents {
+        R"({"keys": ["a", "b"], "items": [{"id": 1, "name": "n", "ref": "a", "value": {"x": true}}]})",
+        R"( { "keys" : [ ] , "items" : [ { "id" : 0 , "name" : "\u0444\ud83d\ude00\n" } ] } )",
+        R"({"items": [{"id": 1, "name": "n", "ref": "a"}], "keys": ["a"]})",                   // Out of order
+        R"({"items": [{"name": "n", "id": 1, "ref": "b"}], "keys": ["a"]})",
+        R"({"keys": ["a"], "items": [{"id": 1, "name": "n", "ref": "b"}]})",
+        R"({"keys": ["a"], "items": [{"id": 1, "name": "n", "value": {"x": 1}}]})",
+        R"({"keys": ["a"], "items": [{"id": 1, "name": "n", "value": "s"}]})",
+        R"({"keys": ["a"], "items": [{"id": 1.5, "name": "n"}]})",
+        R"({"keys": ["a"], "items": [{"id": 7000000000, "name": "n", "extra": [1, {"a": [null]}]}]})",
+        R"({"keys": ["a"], "items": [{"id": 1}]})",
+        R"({"keys": ["a"], "items": []})",
+        R"({"keys": ["a"], "items": {}})",
+        R"({"keys": ["a", "b"], "items": [{"id": 1, "name": "n"}], "sizes": [1, 2]})",
+        R"({"keys": ["a", "b"], "items": [{"id": 1, "name": "n"}], "sizes": [1]})",
+        R"({"keys": ["a", "b"], "items": [{"id": 1, "name": "n"}], "sizes": [1, "2"]})",
+        R"({"keys": "a", "items": []})",
+        R"({"keys": ["a"], "items": [{"name": "", "id": -1}]})",
+        R"([])",
+    };
+
+    for (const auto& x : documents) {
+        const auto description = x.toStdString();
+        const auto value = QJsonDocument::fromJson(x.toUtf8());
+        ASSERT_FALSE(value.isNull()) << description;
+
+        ErrorInfo expected;
+        ErrorInfo actual;
+        ContextData expectedCtx;
+        ContextData actualCtx;
+        Path path;
+
+        const auto jsonValue = value.isObject() ? QJsonValue(value.object()) : QJsonValue(value.array());
+        const auto expectedResult = validator->check(expectedCtx, expected, path, jsonValue);
+
+        ASSERT_EQ(compiled->checkUtf8(actualCtx, actual, x.toUtf8()), expectedResult) << description;
+        ASSERT_EQ(actual.getErrorPath(), expected.getErrorPath()) << description;
+        ASSERT_EQ(actual.getErrorDescription(), expected.getErrorDescription()) << description;
+        ASSERT_EQ(actualCtx, expectedCtx) << description;
+    }
+
+    // Syntax errors
+    for (const auto& x : {R"({"keys": ["a"], "items": [{"id": 1, "name": "n"}]} x)",
+                          R"({"keys": ["a"], "items": [{"id": 1, "name": "n"})",
+                          R"({"keys": ["a" "b"]})",
+                          R"({"keys": [01]})",
+                          R"({"keys": ["a\x"]})",
+                          R"({"keys": [tru]})",
+                          ""}) {
+        ErrorInfo lg;
+        ASSERT_FALSE(compiled->checkUtf8(lg, x)) << x;
+        ASSERT_TRUE(lg.getErrorDescription().startsWith("Invalid JSON at offset")) << x;
+    }
+
+    ErrorInfo lg;
+    ASSERT_FALSE(compiled->checkUtf8(lg, R"({"keys": [], "items": [{"id": 1, "name": "n"}, 5]})"));
+    ASSERT_EQ(lg.getErrorPath(), "/items[1]");
+
+    // Duplicate keys: the first value is validated (QJsonDocument keeps the last one)
+    ASSERT_FALSE(compiled->checkUtf8(lg, R"({"keys": [], "items": [{"id": -1, "name": "n", "id": 1}]})"));
+    ASSERT_EQ(lg.getErrorPath(), "/items[0]/id");
+    ASSERT_TRUE(compiled->checkUtf8(lg, R"({"keys": [], "items": [{"id": 1, "name": "n", "id": -1}]})"));
+    ASSERT_TRUE(compiled->checkUtf8(lg, R"({"keys": [], "items": [{"name": "n", "name": "", "id": 1}]})")); // Out of order
+
+    // The same for objects, which are built as a whole (under Or)
+    const auto orCompiled = Compile(RootValidator(Object(Field("value", Or(String(), Object(Field("x", Bool())))))));
+    ASSERT_FALSE(orCompiled->checkUtf8(lg, R"({"value": {"x": 1, "x": true}})"));
+    ASSERT_TRUE(orCompiled->checkUtf8(lg, R"({"value": {"x": true, "x": 1}})"));
+
+    // Device and file
+    QJsonArray items;
+    for (int i = 0; i < 20000; i++)
+        items.append(QJsonObject{{"id", i}, {"name", QString("item-%1").arg(i)}});
+
+    const auto bytes = QJsonDocument(QJsonObject{{"keys", QJsonArray()}, {"items", items}}).toJson();
+
+    QBuffer buffer;
+    buffer.setData(bytes);
+    ASSERT_TRUE(buffer.open(QIODevice::ReadOnly));
+    ASSERT_TRUE(compiled->checkDevice(lg, buffer));
+
+    QTemporaryFile file;
+    ASSERT_TRUE(file.open());
+    ASSERT_EQ(file.write(bytes), bytes.size());
+    file.close();
+
+    ASSERT_TRUE(compiled->checkFile(lg, file.fileName()));
+    ASSERT_TRUE(compiled->checkFile(lg, file.fileName(), FileAccess::Read));
+    ASSERT_FALSE(compiled->checkFile(lg, file.fileName() + "-missing"));
+}
@@ -4,13 +4,16 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <utility>
 #include <tuple>
+#include <utils-cpp/middle_iterator.h>
 
 #include <UtilsQt/Qml-Cpp/PathElider.h>
 
 #include <QString>
 #include <QFontMetrics>
+#include <QThreadPool>
 
 #ifndef UTILS_QT_NO_GUI_TESTS
 namespace {
@@ -31,6 +34,40 @@ struct DataPack2
     QString expElided;
 };
 
+// Straightforward elision, every candidate is measured as a whole
+QString referenceElide(const QString& path, const QFont& font, int widthLimit)
+{
+    const QFontMetrics metrics(font);
+
+    if (metrics.horizontalAdvance(path) <= widthLimit)
+        return path;
+
+    PathElider elider;
+    const auto decomposition = elider.decomposePath(path);
+
+    std::vector<bool> skipDirs(decomposition.subdirs.size());
+    auto mit = make_middle_iterator(skipDirs.begin(), skipDirs.end());
+    while (mit.isValid()) {
+        *mit++ = true;
+        const auto str = decomposition.combine(skipDirs);
+        if (metrics.horizontalAdvance(str) <= widthLimit)
+            return str;
+    }
+
+    const auto onlyName = decomposition.subdirs.isEmpty() && decomposition.protocol.isEmpty() ?
+                              decomposition.name :
+                              QStringLiteral("...") + decomposition.separator.value_or('/') + decomposition.name;
+    if (metrics.horizontalAdvance(onlyName) <= widthLimit)
+        return onlyName;
+
+    auto str = "..." + decomposition.name;
+    for (; str.size() > 3; str.remove(3, 1))
+        if (metrics.horizontalAdvance(str) <= widthLimit)
+            return str;
+
+    return {};
+}
+
 class PathElider_Basic0_Combine : public testing::TestWithParam<DataPack1>
 {
 public:
@@ -67,6 +104,80 @@ TEST_P(PathElider_Basic1_Regexp, Test)
     ASSERT_EQ(elider.elidedText(), dataPack.expElided);
 }
 
+TEST(UtilsQt, PathElider_Widths)
+{
+    const QStringList paths {
+        ":/devices/MX-10/EU/image.png",
+        "qrc:/devices/MX-10/EU/very_long_image_name_with_many_characters.png",
+        "/home/user/projects/utils-qt/src/Qml-Cpp/PathElider.cpp",
+        "D:\\subdir\\image.png",
+        "somedir1/somedir2/",
+        "image.png",
+        "/AV/To/Wa/YA/LT/AVATAR.../Ty.png", // Kerning pairs at joints
+        "/ffi/fl/ff/office/ffl"             // Ligatures
+    };
+
+    // Kerning grows with font size
+    for (const auto& font : {QFont(QString("Arial")), QFont(QString("Arial"), 48), QFont(QString("Times New Roman"), 72)}) {
+        // Eliders share measured segments, results must not depend on it
+        PathElider elider1;
+        PathElider elider2;
+        elider1.setFont(font);
+        elider2.setFont(font);
+
+        for (const auto& path : paths) {
+            elider1.setSourceText(path);
+            elider2.setSourceText(path);
+
+            const auto fullWidth = QFontMetrics(font).horizontalAdvance(path);
+            const auto step = std::max(1, font.pointSize() / 4);
+
+            for (int width = fullWidth + 5; width > 0; width -= step) {
+                elider1.setWidthLimit(width);
+                elider2.setWidthLimit(width);
+
+                const auto expected = referenceElide(path, font, width);
+                ASSERT_EQ(elider1.elidedText(), expected) << path.toStdString() << " " << width << " " << font.pointSize();
+                ASSERT_EQ(elider2.elidedText(), expected) << path.toStdString() << " " << width << " " << font.pointSize();
+            }
+        }
+    }
+}
+
+TEST(UtilsQt, PathElider_ElideAll)
+{
+    const QFont font {QString("Arial")};
+    QStringList paths;
+
+    for (int i = 0; i < 1000; i++)
+        paths.append(QString("/home/user/dir_%1/subdir/file_%2.txt").arg(i % 7).arg(i));
+    paths << "" << "image.png" << "D:\\subdir\\image.png";
+
+    ASSERT_TRUE(PathElider::elideAll({}, font, 100).isEmpty());
+
+    const auto noWidth = PathElider::elideAll(paths, font, 0);
+    ASSERT_EQ(noWidth.size(), paths.size());
+    ASSERT_TRUE(std::all_of(noWidth.cbegin(), noWidth.cend(), [](const QString& x) { return x.isEmpty(); }));
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    for (int width : {20, 80, 150, 1000}) {
+        PathElider elider;
+        elider.setFont(font);
+        elider.setWidthLimit(width);
+
+        QStringList expected;
+        for (const auto& path : paths) {
+            elider.setSourceText(path);
+            expected.append(elider.elidedText());
+        }
+
+        ASSERT_EQ(PathElider::elideAll(paths, font, width), expected);
+        ASSERT_EQ(PathElider::elideAll(paths, font, width, &pool), expected);
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     Test,
     PathElider_Basic0_Combine,
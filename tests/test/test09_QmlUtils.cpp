@@ -11,7 +11,13 @@
 #include <QEventLoop>
 #include <QTimer>
 #include <QSignalSpy>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+#include <QImage>
 #include <UtilsQt/Qml-Cpp/QmlUtils.h>
+#include <UtilsQt/Futures/Utils.h>
 
 namespace {
 
@@ -165,3 +171,133 @@ INSTANTIATE_TEST_SUITE_P(
         DataPack_ColorChangeAlpha{QColor::fromCmykF(0.1, 0.2, 0.1, 0.1, 0.1), 0.14}
     )
 );
+
+TEST(UtilsQt, QmlUtils_RegexOptions)
+{
+    auto& utils = QmlUtils::instance();
+
+    // Same pattern with different options is cached separately
+    ASSERT_EQ(utils.extractByRegex("ABC", "b"), "");
+    ASSERT_EQ(utils.extractByRegex("ABC", "b", QRegularExpression::CaseInsensitiveOption), "B");
+    ASSERT_EQ(utils.extractByRegex("ABC", "b"), "");
+    ASSERT_EQ(utils.extractByRegexGroups("A-1", "a-(\\d)", {1}, QRegularExpression::CaseInsensitiveOption), QStringList({"1"}));
+
+    // Cache eviction doesn't affect results
+    for (int i = 0; i < 200; i++)
+        ASSERT_EQ(utils.extractByRegex(QString("x%1y").arg(i), QString("%1").arg(i)), QString::number(i));
+}
+
+TEST(UtilsQt, QmlUtils_RegexBatch)
+{
+    auto& utils = QmlUtils::instance();
+
+    QStringList sources;
+    QStringList expected;
+
+    for (int i = 0; i < 10000; i++) {
+        sources.append(i % 3 ? QString("item-%1.png").arg(i) : QString("no digits"));
+        expected.append(i % 3 ? QString::number(i) : QString(""));
+    }
+
+    ASSERT_EQ(utils.extractByRegexBatch(sources, "\\d+"), expected);
+    ASSERT_EQ(utils.extractByRegexBatch(sources, "\\d+", 0, true), expected);
+    ASSERT_TRUE(utils.extractByRegexBatch({}, "\\d+", 0, true).isEmpty());
+}
+
+TEST(UtilsQt, QmlUtils_ListFilesAsync)
+{
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+
+    const QDir root(tempDir.path());
+    for (const auto& dir : {"a", "a/b", "c", "d/e/f"})
+        ASSERT_TRUE(root.mkpath(dir));
+
+    for (const auto& file : {"1.txt", "2.dat", "a/3.txt", "a/b/4.txt", "c/5.TXT", "d/e/f/6.txt", "d/e/7.dat"}) {
+        QFile f(root.filePath(file));
+        ASSERT_TRUE(f.open(QIODevice::WriteOnly));
+    }
+
+    auto& utils = QmlUtils::instance();
+    const QStringList filters {"*.txt", "*.TXT"};
+
+    for (bool recursive : {false, true}) {
+        const auto expected = utils.listFiles(tempDir.path(), filters, recursive);
+
+        for (bool parallel : {false, true}) {
+            auto f = utils.listFilesAsync(tempDir.path(), filters, {recursive, true, parallel});
+            UtilsQt::waitForFuture<QEventLoop>(f);
+            ASSERT_FALSE(f.isCanceled());
+            ASSERT_EQ(f.result(), expected);
+
+            f = utils.listFilesAsync(tempDir.path(), filters, {recursive, false, parallel});
+            UtilsQt::waitForFuture<QEventLoop>(f);
+            auto unordered = f.result();
+            unordered.sort(Qt::CaseInsensitive);
+            ASSERT_EQ(unordered, expected);
+        }
+    }
+
+    // Cancellation
+    auto f = utils.listFilesAsync(tempDir.path(), filters, {true, true, true});
+    f.cancel();
+    UtilsQt::waitForFuture<QEventLoop>(f);
+    ASSERT_TRUE(f.isFinished()); // Could be already finished before cancel
+}
+
+TEST(UtilsQt, QmlUtils_ImageMetadata)
+{
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+
+    const QDir root(tempDir.path());
+    ASSERT_TRUE(root.mkpath("sub"));
+
+    auto saveImage = [&root](const QString& name, const QSize& size) {
+        QImage image(size, QImage::Format_ARGB32);
+        image.fill(Qt::red);
+        return image.save(root.filePath(name), "PNG");
+    };
+
+    ASSERT_TRUE(saveImage("1.png", {10, 20}));
+    ASSERT_TRUE(saveImage("sub/2.png", {30, 40}));
+
+    QFile textFile(root.filePath("3.txt"));
+    ASSERT_TRUE(textFile.open(QIODevice::WriteOnly));
+    textFile.write("Not an image");
+    textFile.close();
+
+    auto& utils = QmlUtils::instance();
+
+    // Prefetch
+    auto f = utils.prefetchImageMetadata(tempDir.path(), {}, false);
+    UtilsQt::waitForFuture<QEventLoop>(f);
+    ASSERT_EQ(f.result(), 1);
+
+    f = utils.prefetchImageMetadata(tempDir.path(), {}, true);
+    UtilsQt::waitForFuture<QEventLoop>(f);
+    ASSERT_EQ(f.result(), 2);
+
+    f = utils.prefetchImageMetadata(QStringList{root.filePath("1.png"), root.filePath("3.txt"), root.filePath("absent.png")});
+    UtilsQt::waitForFuture<QEventLoop>(f);
+    ASSERT_EQ(f.result(), 1);
+
+    // Metadata
+    const auto metadata = utils.imageMetadata(root.filePath("sub/2.png"));
+    ASSERT_TRUE(metadata.isValid());
+    ASSERT_EQ(metadata.format, QByteArray("png"));
+    ASSERT_EQ(metadata.size, QSize(30, 40));
+    ASSERT_EQ(metadata.orientedSize(), QSize(30, 40));
+
+    ASSERT_TRUE(utils.isImage(root.filePath("1.png")));
+    ASSERT_EQ(utils.imageSize(root.filePath("1.png")), QSize(10, 20));
+    ASSERT_FALSE(utils.isImage(root.filePath("3.txt")));
+    ASSERT_FALSE(utils.imageSize(root.filePath("3.txt")).isValid());
+    ASSERT_FALSE(utils.isImage(root.filePath("absent.png")));
+
+    // Cached entry is dropped when file changes
+    ASSERT_TRUE(saveImage("1.png", {200, 100}));
+    ASSERT_EQ(utils.imageSize(root.filePath("1.png")), QSize(200, 100));
+    ASSERT_TRUE(saveImage("absent.png", {5, 5}));
+    ASSERT_TRUE(utils.isImage(root.filePath("absent.png")));
+}
@@ -4,6 +4,10 @@
 
 #include <gtest/gtest.h>
 #include <UtilsQt/Qml-Cpp/Geometry/Geometry.h>
+#include <UtilsQt/Qml-Cpp/Geometry/Polygon.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
 
 
 TEST(UtilsQt, Geomtry)
@@ -25,3 +29,184 @@ TEST(UtilsQt, Geomtry)
     ASSERT_TRUE(Geometry::instance().isPolygonRectangular(rect));
     ASSERT_FALSE(Geometry::instance().isPolygonRectangular(nonRect));
 }
+
+TEST(UtilsQt, Geometry_PolygonIndex)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<qreal> position(0, 1000);
+    std::uniform_real_distribution<qreal> extent(1, 60);
+
+    QVector<QPolygonF> polygons;
+
+    for (int i = 0; i < 300; i++) {
+        const QPointF origin(position(generator), position(generator));
+        const auto w = extent(generator);
+        const auto h = extent(generator);
+
+        if (i % 2) {
+            polygons.append(QPolygonF({origin, origin + QPointF(w, 0), origin + QPointF(w / 2, h)}));
+        } else {
+            polygons.append(QPolygonF(QRectF(origin, QSizeF(w, h))));
+        }
+    }
+
+    Polygon polygon;
+    polygon.setPolygons(polygons);
+
+    auto check = [&](const QPointF& offset) {
+        QVector<QPolygonF> translated = polygons;
+        for (auto& x : translated)
+            x.translate(offset);
+
+        for (int i = 0; i < 2000; i++) {
+            const QPointF point(position(generator), position(generator));
+            const auto expected = std::any_of(translated.cbegin(), translated.cend(), [&](const auto& x) { return x.containsPoint(point, Qt::OddEvenFill); });
+            ASSERT_EQ(polygon.intersectsWithPoint(point), expected);
+        }
+
+        for (int i = 0; i < 500; i++) {
+            const QRectF rect(position(generator), position(generator), extent(generator), extent(generator));
+            const QPolygonF rectPolygon(rect);
+            const auto expected = std::any_of(translated.cbegin(), translated.cend(), [&](const auto& x) { return rectPolygon.intersects(x); });
+            ASSERT_EQ(polygon.intersectsWithRect(rect), expected);
+        }
+    };
+
+    check({});
+
+    polygon.setOffset({16.5, -8.25});
+    check({16.5, -8.25});
+
+    polygon.setNegativeOffset(true);
+    check({-16.5, 8.25});
+
+    // Outside, empty
+    ASSERT_FALSE(polygon.intersectsWithPoint({-5000, -5000}));
+    ASSERT_FALSE(polygon.intersectsWithRect({-5000, -5000, 10, 10}));
+    ASSERT_TRUE(polygon.intersectsWithRect({-5000, -5000, 10000, 10000}));
+
+    polygon.setPolygons({});
+    ASSERT_FALSE(polygon.intersectsWithPoint({500, 500}));
+    ASSERT_FALSE(polygon.intersectsWithRect({0, 0, 1000, 1000}));
+}
+
+TEST(UtilsQt, Geometry_BatchTransforms)
+{
+    auto& geometry = Geometry::instance();
+
+    QVector<QPolygonF> polygons;
+
+    for (int i = 0; i < 50; i++)
+        polygons.append(QPolygonF({{qreal(i), qreal(-i)}, {i * 2.5, 3.0}, {-1.0, i * 0.5}}));
+
+    const auto polygonsBounds = [](const QVector<QPolygonF>& x) {
+        QRectF result;
+        for (const auto& polygon : x)
+            result |= polygon.boundingRect();
+        return result;
+    };
+
+    ASSERT_EQ(geometry.polygonsBoundingRect(polygons), polygonsBounds(polygons));
+    ASSERT_EQ(geometry.polygonsBoundingRect({}), QRectF());
+
+    // Scale
+    const auto scaled = geometry.polygonsScale(polygons, 2, -3);
+    ASSERT_EQ(scaled[7][1], QPointF(7 * 2.5 * 2, -9));
+
+    // Translate
+    auto translated = polygons;
+    const auto translatedBounds = geometry.polygonsTranslateRef(translated, 10, -20);
+    ASSERT_EQ(translated[3][0], QPointF(13, -23));
+    ASSERT_EQ(translatedBounds, polygonsBounds(translated));
+    ASSERT_EQ(geometry.polygonsTranslate(polygons, 10, -20), translated);
+
+    // Affine and perspective
+    QTransform rotation;
+    rotation.translate(5, 7).rotate(30).scale(2, 0.5);
+
+    const QTransform projection(1, 0, 0.001,
+                                0, 1, 0.002,
+                                3, 4, 1);
+
+    for (const auto& transform : {QTransform(), QTransform::fromTranslate(1, 2), QTransform::fromScale(2, 3), rotation, projection}) {
+        auto actual = polygons;
+        const auto bounds = geometry.polygonsTransformRef(actual, transform);
+
+        for (int i = 0; i < polygons.size(); i++) {
+            const auto expected = transform.map(polygons[i]);
+
+            for (int j = 0; j < expected.size(); j++) {
+                ASSERT_NEAR(actual[i][j].x(), expected[j].x(), 1e-9);
+                ASSERT_NEAR(actual[i][j].y(), expected[j].y(), 1e-9);
+            }
+        }
+
+        ASSERT_EQ(bounds, polygonsBounds(actual));
+        ASSERT_EQ(geometry.polygonsTransform(polygons, transform), actual);
+    }
+}
+
+TEST(UtilsQt, Geometry_PointsInPolygon)
+{
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<qreal> position(-120, 120);
+    constexpr qreal pi = 3.14159265358979323846;
+
+    // Self-intersecting star (fill rules differ) and irregular "blob" with horizontal edges
+    QPolygonF star;
+    for (int i = 0; i < 101; i++) {
+        const auto angle = i * 2 * pi * 37 / 101;
+        star.append(QPointF(100 * std::cos(angle), 100 * std::sin(angle)));
+    }
+
+    QPolygonF blob;
+    for (int i = 0; i < 400; i++) {
+        const auto angle = i * 2 * pi / 400;
+        const auto radius = 50 + 40 * std::sin(angle * 7) + (i % 10 == 0 ? 5 : 0);
+        blob.append(QPointF(std::round(radius * std::cos(angle)), std::round(radius * std::sin(angle))));
+    }
+
+    for (const auto& polygon : {star, blob}) {
+        QVector<QPointF> points;
+        for (int i = 0; i < 5000; i++)
+            points.append(QPointF(position(generator), position(generator)));
+
+        // Vertices and integer coordinates are on the edges
+        for (const auto& x : polygon)
+            points.append(x);
+
+        for (int i = 0; i < 1000; i++)
+            points.append(QPointF(std::round(position(generator)), std::round(position(generator))));
+
+        for (const auto fillRule : {Qt::OddEvenFill, Qt::WindingFill}) {
+            QVector<int> expected;
+            for (int i = 0; i < points.size(); i++)
+                if (polygon.containsPoint(points[i], fillRule))
+                    expected.append(i);
+
+            ASSERT_EQ(Geometry::instance().pointsInPolygon(polygon, points, fillRule), expected);
+        }
+
+        // Polygon set
+        Polygon polygonSet;
+        polygonSet.setPolygons({polygon, QPolygonF(QRectF(200, 200, 10, 10))});
+        polygonSet.setOffset({3, 4});
+        points.append(QPointF(205, 205) + QPointF(3, 4));
+
+        QVector<int> expected;
+        for (int i = 0; i < points.size(); i++) {
+            const auto point = points[i] - QPointF(3, 4);
+            if (polygon.containsPoint(point, Qt::OddEvenFill) || QPolygonF(QRectF(200, 200, 10, 10)).containsPoint(point, Qt::OddEvenFill))
+                expected.append(i);
+        }
+
+        const auto actual = polygonSet.intersectingPoints(points);
+        ASSERT_EQ(actual, expected);
+        ASSERT_EQ(actual.last(), points.size() - 1);
+
+        for (int i = 0; i < 200; i++)
+            ASSERT_EQ(polygonSet.intersectsWithPoint(points[i]), expected.contains(i));
+    }
+
+    ASSERT_TRUE(Geometry::instance().pointsInPolygon({}, {QPointF()}).isEmpty());
+}
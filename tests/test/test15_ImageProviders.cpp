@@ -0,0 +1,165 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/utils-qt
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QImage>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <memory>
+#include <UtilsQt/Qml/ImageProviderScaled.h>
+#include <UtilsQt/Qml/ImageProviderBorderImage.h>
+
+#ifndef UTILS_QT_NO_GUI_TESTS
+
+namespace {
+
+bool saveImage(const QString& path, const QSize& size, const QColor& color)
+{
+    QImage image(size, QImage::Format_ARGB32);
+    image.fill(color);
+    return image.save(path, "PNG");
+}
+
+// 30x30: red 10x10 corners, green edges, blue center
+bool saveNinePatch(const QString& path)
+{
+    QImage image(30, 30, QImage::Format_ARGB32);
+
+    for (int y = 0; y < 30; y++) {
+        for (int x = 0; x < 30; x++) {
+            const bool edgeX = (x < 10 || x >= 20);
+            const bool edgeY = (y < 10 || y >= 20);
+            image.setPixelColor(x, y, edgeX && edgeY ? Qt::red : edgeX || edgeY ? Qt::green : Qt::blue);
+        }
+    }
+
+    return image.save(path, "PNG");
+}
+
+} // namespace
+
+TEST(UtilsQt, ImageProviderScaled_Cache)
+{
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+
+    const auto path = QDir(tempDir.path()).filePath("1.png");
+    ASSERT_TRUE(saveImage(path, {100, 50}, Qt::red));
+
+    ImageProviderScaled::clearCache();
+    ImageProviderScaled provider;
+    QSize size;
+
+    const auto image1 = provider.requestImage(path, &size, {20, 10});
+    ASSERT_EQ(size, QSize(100, 50));
+    ASSERT_EQ(image1.size(), QSize(20, 10));
+    ASSERT_EQ(image1.pixelColor(5, 5), QColor(Qt::red));
+
+    // Cached
+    const auto image2 = provider.requestImage(path, &size, {20, 10});
+    ASSERT_EQ(image2.cacheKey(), image1.cacheKey());
+
+    // Another size
+    const auto image3 = provider.requestImage(path, &size, {40, 20});
+    ASSERT_EQ(image3.size(), QSize(40, 20));
+    ASSERT_NE(image3.cacheKey(), image1.cacheKey());
+
+    // File changed
+    ASSERT_TRUE(saveImage(path, {200, 80}, Qt::blue));
+    const auto image4 = provider.requestImage(path, &size, {20, 10});
+    ASSERT_EQ(size, QSize(200, 80));
+    ASSERT_NE(image4.cacheKey(), image1.cacheKey());
+    ASSERT_EQ(image4.pixelColor(5, 5), QColor(Qt::blue));
+
+    // Limit
+    ImageProviderScaled::setCacheLimit(0);
+    const auto image5 = provider.requestImage(path, &size, {20, 10});
+    const auto image6 = provider.requestImage(path, &size, {20, 10});
+    ASSERT_NE(image5.cacheKey(), image6.cacheKey());
+    ImageProviderScaled::setCacheLimit(ImageProviderScaled::DefaultCacheLimit);
+
+    // Invalid size
+    ASSERT_EQ(provider.requestImage(path, &size, {}).size(), QSize(1, 1));
+}
+
+TEST(UtilsQt, ImageProviderScaled_Async)
+{
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+
+    const auto path = QDir(tempDir.path()).filePath("1.png");
+    ASSERT_TRUE(saveImage(path, {100, 50}, Qt::green));
+
+    ImageProviderScaledAsync provider;
+
+    for (const auto& requestedSize : {QSize(30, 15), QSize(30, 15), QSize()}) {
+        std::unique_ptr<QQuickImageResponse> response(provider.requestImageResponse(path, requestedSize));
+        QSignalSpy spy(response.get(), &QQuickImageResponse::finished);
+        ASSERT_TRUE(spy.count() || spy.wait());
+        ASSERT_TRUE(response->errorString().isEmpty());
+
+        std::unique_ptr<QQuickTextureFactory> factory(response->textureFactory());
+        const auto image = factory->image();
+        ASSERT_EQ(image.size(), requestedSize.isValid() ? requestedSize : QSize(1, 1));
+
+        if (requestedSize.isValid())
+            ASSERT_EQ(image.pixelColor(5, 5), QColor(Qt::green));
+    }
+}
+
+TEST(UtilsQt, ImageProviderBorderImage)
+{
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+
+    const auto path = QDir(tempDir.path()).filePath("1.png");
+    ASSERT_TRUE(saveNinePatch(path));
+
+    ImageProviderBorderImage::clearCache();
+    ImageProviderBorderImage provider;
+    QSize size;
+
+    for (const auto& fill : {"stretch", "tile"}) {
+        const auto id = QString("path=%1&orientation=vertical&top=10&bottom=10&left=10&right=10&fill=%2").arg(path, fill);
+
+        const auto image = provider.requestImage(id, &size, {30, 95});
+        ASSERT_EQ(size, QSize(30, 95));
+        ASSERT_EQ(image.size(), QSize(30, 95));
+
+        ASSERT_EQ(image.pixelColor(0, 0), QColor(Qt::red));
+        ASSERT_EQ(image.pixelColor(29, 94), QColor(Qt::red));
+        ASSERT_EQ(image.pixelColor(0, 85), QColor(Qt::red));
+        ASSERT_EQ(image.pixelColor(15, 5), QColor(Qt::green));
+        ASSERT_EQ(image.pixelColor(0, 50), QColor(Qt::green));
+        ASSERT_EQ(image.pixelColor(29, 80), QColor(Qt::green));
+        ASSERT_EQ(image.pixelColor(15, 12), QColor(Qt::blue));
+        ASSERT_EQ(image.pixelColor(15, 84), QColor(Qt::blue));
+
+        // Cached
+        ASSERT_EQ(provider.requestImage(id, &size, {30, 95}).cacheKey(), image.cacheKey());
+
+        // Scaled source: borders are 20px (boundaries are blended by smooth scaling, so not checked)
+        const auto image2 = provider.requestImage(id, &size, {60, 100});
+        ASSERT_EQ(image2.size(), QSize(60, 100));
+        ASSERT_EQ(image2.pixelColor(10, 10), QColor(Qt::red));
+        ASSERT_EQ(image2.pixelColor(30, 10), QColor(Qt::green));
+        ASSERT_EQ(image2.pixelColor(10, 50), QColor(Qt::green));
+        ASSERT_EQ(image2.pixelColor(30, 50), QColor(Qt::blue));
+        ASSERT_EQ(image2.pixelColor(50, 90), QColor(Qt::red));
+
+        // Borders exceed requested height: regions are clipped, not skipped
+        const auto image3 = provider.requestImage(id, &size, {30, 5});
+        ASSERT_EQ(image3.size(), QSize(30, 5));
+        ASSERT_EQ(image3.pixelColor(0, 0), QColor(Qt::red));
+        ASSERT_EQ(image3.pixelColor(29, 4), QColor(Qt::red));
+        ASSERT_EQ(image3.pixelColor(15, 2), QColor(Qt::green));
+    }
+
+    // Invalid size
+    ASSERT_EQ(provider.requestImage("path=" + path, &size, {}).size(), QSize(10, 10));
+}
+
+#endif // !UTILS_QT_NO_GUI_TESTS